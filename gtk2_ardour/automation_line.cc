@@ -53,6 +53,7 @@
 
 #include "evoral/Curve.h"
 
+#include "canvas/canvas.h"
 #include "canvas/debug.h"
 
 #include "automation_line.h"
@@ -94,6 +95,10 @@ AutomationLine::AutomationLine (const string&                              name,
 	, _offset (0)
 	, _maximum_time (max_samplepos)
 	, _fill (false)
+	, _line_decimated (false)
+	, _line_points_dirty (false)
+	, _displayable_x0 (0)
+	, _displayable_x1 (0)
 	, _desc (desc)
 {
 	if (converter) {
@@ -122,6 +127,8 @@ AutomationLine::AutomationLine (const string&                              name,
 
 	line->Event.connect (sigc::mem_fun (*this, &AutomationLine::event_handler));
 
+	trackview.editor().HorizontalPositionChanged.connect (sigc::mem_fun (*this, &AutomationLine::horizontal_position_changed));
+
 	trackview.session()->register_with_memento_command_factory(alist->id(), this);
 
 	interpolation_changed (alist->interpolation ());
@@ -167,8 +174,12 @@ AutomationLine::update_visibility ()
 		}
 
 		if (_visible & ControlPoints) {
-			for (vector<ControlPoint*>::iterator i = control_points.begin(); i != control_points.end(); ++i) {
-				(*i)->show ();
+			for (uint32_t n = 0; n < control_points.size(); ++n) {
+				if (displayable (n)) {
+					control_points[n]->show ();
+				} else {
+					control_points[n]->hide ();
+				}
 			}
 		} else if (_visible & SelectedControlPoints) {
 			for (vector<ControlPoint*>::iterator i = control_points.begin(); i != control_points.end(); ++i) {
@@ -186,16 +197,88 @@ AutomationLine::update_visibility ()
 
 	} else {
 		line->hide ();
-		for (vector<ControlPoint*>::iterator i = control_points.begin(); i != control_points.end(); ++i) {
-			if (_visible & ControlPoints) {
-				(*i)->show ();
+		for (uint32_t n = 0; n < control_points.size(); ++n) {
+			if ((_visible & ControlPoints) && displayable (n)) {
+				control_points[n]->show ();
 			} else {
-				(*i)->hide ();
+				control_points[n]->hide ();
 			}
 		}
 	}
 }
 
+/** Decide which control points get a canvas item.
+ *
+ *  Only points within (or close to) the visible part of the canvas are
+ *  considered, and of those only points at least a control point's size
+ *  apart from the previous one; denser points could neither be seen nor
+ *  clicked individually. Selected points are always displayable.
+ */
+void
+AutomationLine::compute_displayable_points ()
+{
+	_displayable.assign (control_points.size(), false);
+
+	ArdourCanvas::Rect visible = group->canvas()->visible_area ();
+
+	if (visible) {
+		visible = group->window_to_item (visible);
+		/* keep a page either side, so that scrolling does not
+		 * require recomputing this for every step
+		 */
+		const double page = visible.width ();
+		_displayable_x0 = visible.x0 - page;
+		_displayable_x1 = visible.x1 + page;
+	} else {
+		_displayable_x0 = -DBL_MAX;
+		_displayable_x1 = DBL_MAX;
+	}
+
+	const double min_spacing = control_point_box_size ();
+	const uint32_t last = control_points.size() - 1;
+	double last_x = -DBL_MAX;
+
+	for (uint32_t n = 0; n < control_points.size(); ++n) {
+		ControlPoint const * cp = control_points[n];
+		const double x = cp->get_x ();
+
+		if (x < _displayable_x0 || x > _displayable_x1) {
+			continue;
+		}
+
+		if (cp->selected () || n == 0 || n == last || x - last_x >= min_spacing) {
+			_displayable[n] = true;
+			last_x = x;
+		}
+	}
+}
+
+bool
+AutomationLine::displayable (uint32_t n) const
+{
+	return (n < _displayable.size() && _displayable[n]) || control_points[n]->selected ();
+}
+
+void
+AutomationLine::horizontal_position_changed ()
+{
+	if (!(_visible & ControlPoints) || control_points.empty ()) {
+		return;
+	}
+
+	ArdourCanvas::Rect visible = group->canvas()->visible_area ();
+
+	if (visible) {
+		visible = group->window_to_item (visible);
+		if (visible.x0 >= _displayable_x0 && visible.x1 <= _displayable_x1) {
+			return;
+		}
+	}
+
+	compute_displayable_points ();
+	update_visibility ();
+}
+
 bool
 AutomationLine::get_uses_gain_mapping () const
 {
@@ -307,10 +390,7 @@ AutomationLine::modify_point_y (ControlPoint& cp, double y)
 	alist->thaw ();
 
 	reset_line_coords (cp);
-
-	if (line_points.size() > 1) {
-		line->set_steps (line_points, is_stepped());
-	}
+	set_line_steps ();
 
 	update_pending = false;
 
@@ -324,6 +404,12 @@ AutomationLine::modify_point_y (ControlPoint& cp, double y)
 void
 AutomationLine::reset_line_coords (ControlPoint& cp)
 {
+	if (_line_decimated) {
+		/* line points do not correspond to control points */
+		_line_points_dirty = true;
+		return;
+	}
+
 	if (cp.view_index() < line_points.size()) {
 		line_points[cp.view_index()].x = cp.get_x ();
 		line_points[cp.view_index()].y = cp.get_y ();
@@ -701,9 +787,7 @@ AutomationLine::drag_motion (double const x, float fraction, bool ignore_x, bool
 
 		/* update actual line coordinates (will queue a redraw) */
 
-		if (line_points.size() > 1) {
-			line->set_steps (line_points, is_stepped());
-		}
+		set_line_steps ();
 	}
 
 	/* calculate effective delta */
@@ -754,7 +838,7 @@ AutomationLine::end_drag (bool with_push, uint32_t final_index)
 	if (moved) {
 		/* A point has moved as a result of sync (clamped to integer or boolean
 		   value), update line accordingly. */
-		line->set_steps (line_points, is_stepped());
+		set_line_steps ();
 	}
 
 	trackview.editor().session()->add_command (
@@ -1029,29 +1113,103 @@ AutomationLine::reset_callback (const Evoral::ControlList& events)
 		control_points.back()->set_can_slide(false);
 	}
 
+	compute_displayable_points ();
+
 	if (vp > 1) {
 
 		/* reset the line coordinates given to the CanvasLine */
 
-		while (line_points.size() < vp) {
-			line_points.push_back (ArdourCanvas::Duple (0,0));
+		update_line_points ();
+		line->set_steps (line_points, is_stepped());
+	}
+
+	update_visibility ();
+
+	set_selected_points (trackview.editor().get_selection().points);
+}
+
+/** Compute line_points from the control points.
+ *
+ *  If there are more control points than pixels, draw only the first,
+ *  lowest, highest and last point within each pixel column. This keeps
+ *  the shape of the line at the current zoom level while reducing the
+ *  number of line segments to a small multiple of the line's width.
+ */
+void
+AutomationLine::update_line_points ()
+{
+	const uint32_t vp = control_points.size();
+
+	line_points.clear ();
+	_line_decimated = false;
+	_line_points_dirty = false;
+
+	if (vp == 0) {
+		return;
+	}
+
+	const double span = control_points.back()->get_x() - control_points.front()->get_x();
+
+	if (vp < 2 * span) {
+		for (uint32_t n = 0; n < vp; ++n) {
+			line_points.push_back (ArdourCanvas::Duple (control_points[n]->get_x(), control_points[n]->get_y()));
 		}
+		return;
+	}
+
+	_line_decimated = true;
+
+	uint32_t n = 0;
 
-		while (line_points.size() > vp) {
-			line_points.pop_back ();
+	while (n < vp) {
+		const double column = floor (control_points[n]->get_x());
+		const uint32_t first = n;
+		uint32_t lo = n;
+		uint32_t hi = n;
+
+		for (++n; n < vp && floor (control_points[n]->get_x()) == column; ++n) {
+			if (control_points[n]->get_y() < control_points[lo]->get_y()) {
+				lo = n;
+			}
+			if (control_points[n]->get_y() > control_points[hi]->get_y()) {
+				hi = n;
+			}
 		}
 
-		for (uint32_t n = 0; n < vp; ++n) {
-			line_points[n].x = control_points[n]->get_x();
-			line_points[n].y = control_points[n]->get_y();
+		const uint32_t last = n - 1;
+
+		/* add in time order, skipping duplicates */
+
+		if (lo > hi) {
+			std::swap (lo, hi);
 		}
 
-		line->set_steps (line_points, is_stepped());
+		line_points.push_back (ArdourCanvas::Duple (control_points[first]->get_x(), control_points[first]->get_y()));
+		if (lo != first) {
+			line_points.push_back (ArdourCanvas::Duple (control_points[lo]->get_x(), control_points[lo]->get_y()));
+		}
+		if (hi != lo && hi != first) {
+			line_points.push_back (ArdourCanvas::Duple (control_points[hi]->get_x(), control_points[hi]->get_y()));
+		}
+		if (last != hi && last != lo && last != first) {
+			line_points.push_back (ArdourCanvas::Duple (control_points[last]->get_x(), control_points[last]->get_y()));
+		}
+	}
+}
 
-		update_visibility ();
+/** Hand line_points to the canvas line, first recomputing them if control
+ *  points moved while the line was decimated.
+ */
+void
+AutomationLine::set_line_steps ()
+{
+	if (_line_points_dirty) {
+		update_line_points ();
 	}
 
-	set_selected_points (trackview.editor().get_selection().points);
+	if (line_points.size() > 1) {
+		line->set_steps (line_points, is_stepped());
+	}
 }
 
 void
@@ -1302,13 +1460,7 @@ AutomationLine::add_visible_control_point (uint32_t view_index, uint32_t pi, dou
 
 	control_points[view_index]->reset (tx, ty, model, view_index, shape);
 
-	/* finally, control visibility */
-
-	if (_visible & ControlPoints) {
-		control_points[view_index]->show ();
-	} else {
-		control_points[view_index]->hide ();
-	}
+	/* visibility is decided by update_visibility(), once all points are known */
 }
 
 void
@@ -236,6 +236,11 @@ private:
 	bool is_stepped() const;
 	void update_visibility ();
 	void reset_line_coords (ControlPoint&);
+	void update_line_points ();
+	void set_line_steps ();
+	void compute_displayable_points ();
+	bool displayable (uint32_t view_index) const;
+	void horizontal_position_changed ();
 	void add_visible_control_point (uint32_t, uint32_t, double, double, ARDOUR::AutomationList::iterator, uint32_t);
 	double control_point_box_size ();
 	void connect_to_list ();
@@ -248,6 +253,21 @@ private:
 
 	bool _fill;
 
+	/** true if line_points holds a min/max decimation of the control
+	 *  points rather than one point per control point
+	 */
+	bool _line_decimated;
+	/** true if line_points needs to be recomputed from the control points */
+	bool _line_points_dirty;
+
+	/** control points that are worth a canvas item at the current zoom and
+	 *  scroll position, by view index; see ::compute_displayable_points()
+	 */
+	std::vector<bool> _displayable;
+	/** x range (in canvas_group() coordinates) that _displayable was computed for */
+	double _displayable_x0;
+	double _displayable_x1;
+
 	const ARDOUR::ParameterDescriptor _desc;
 
 	friend class AudioRegionGainLine;
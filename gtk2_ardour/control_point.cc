@@ -44,14 +44,10 @@ ControlPoint::ControlPoint (AutomationLine& al)
 	_shape = Full;
 	_size = 4.0;
 
-	_item = new ArdourCanvas::Rectangle (&_line.canvas_group());
-	_item->set_fill (true);
-	_item->set_fill_color (UIConfiguration::instance().color ("control point fill"));
-	_item->set_outline_color (UIConfiguration::instance().color ("control point outline"));
-	_item->set_data ("control_point", this);
-	_item->Event.connect (sigc::mem_fun (this, &ControlPoint::event_handler));
-
-	hide ();
+	/* the canvas item is only created once the point is shown, lines
+	 * with many thousands of points never display most of them.
+	 */
+	_item = 0;
 }
 
 ControlPoint::ControlPoint (const ControlPoint& other, bool /*dummy_arg_to_force_special_copy_constructor*/)
@@ -91,22 +87,42 @@ ControlPoint::event_handler (GdkEvent* event)
 	return PublicEditor::instance().canvas_control_point_event (event, _item, this);
 }
 
+void
+ControlPoint::ensure_item () const
+{
+	if (_item) {
+		return;
+	}
+
+	_item = new ArdourCanvas::Rectangle (&_line.canvas_group());
+	_item->set_fill (true);
+	_item->set_data ("control_point", const_cast<ControlPoint*> (this));
+	_item->Event.connect (sigc::mem_fun (const_cast<ControlPoint*> (this), &ControlPoint::event_handler));
+	_item->hide ();
+
+	const_cast<ControlPoint*> (this)->set_color ();
+	const_cast<ControlPoint*> (this)->move_to (_x, _y, _shape);
+}
+
 void
 ControlPoint::hide ()
 {
-	_item->hide();
+	if (_item) {
+		_item->hide();
+	}
 }
 
 void
 ControlPoint::show()
 {
+	ensure_item ();
 	_item->show();
 }
 
 bool
 ControlPoint::visible () const
 {
-	return _item->visible ();
+	return _item && _item->visible ();
 }
 
 void
@@ -120,6 +136,10 @@ ControlPoint::reset (double x, double y, AutomationList::iterator mi, uint32_t v
 void
 ControlPoint::set_color ()
 {
+	if (!_item) {
+		return;
+	}
+
 	if (_selected) {
 		_item->set_outline_color(UIConfiguration::instance().color ("control point selected outline"));;
 		_item->set_fill_color(UIConfiguration::instance().color ("control point selected fill"));
@@ -158,7 +178,9 @@ ControlPoint::move_to (double x, double y, ShapeType shape)
 		break;
 	}
 
-	_item->set (ArdourCanvas::Rect (x1, y - half_size, x2, y + half_size));
+	if (_item) {
+		_item->set (ArdourCanvas::Rect (x1, y - half_size, x2, y + half_size));
+	}
 
 	_x = x;
 	_y = y;
@@ -168,5 +190,6 @@ ControlPoint::move_to (double x, double y, ShapeType shape)
 ArdourCanvas::Item&
 ControlPoint::item() const
 {
+	ensure_item ();
 	return *_item;
 }
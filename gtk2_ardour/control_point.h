@@ -85,7 +85,8 @@ public:
 	static PBD::Signal1<void, ControlPoint *> CatchDeletion;
 
 private:
-	ArdourCanvas::Rectangle*        _item;
+	/** created on demand, see ::ensure_item() */
+	mutable ArdourCanvas::Rectangle* _item;
 	AutomationLine&                  _line;
 	ARDOUR::AutomationList::iterator _model;
 	uint32_t                         _view_index;
@@ -96,6 +97,7 @@ private:
 	ShapeType                        _shape;
 
 	virtual bool event_handler (GdkEvent*);
+	void ensure_item () const;
 
 };
 
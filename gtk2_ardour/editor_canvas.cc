@@ -121,6 +121,10 @@ Editor::initialize_canvas ()
 	/*a group to hold time (measure) lines */
 	time_line_group = new ArdourCanvas::Container (h_scroll_group);
 	CANVAS_DEBUG_NAME (time_line_group, "time line group");
+	/* grid lines only change on zoom/scroll, but are redrawn for every
+	 * playhead, meter or automation-line expose on top of them.
+	 */
+	time_line_group->set_render_cache (true);
 
 	_trackview_group = new ArdourCanvas::Container (hv_scroll_group);
 	CANVAS_DEBUG_NAME (_trackview_group, "Canvas TrackViews");
@@ -1003,6 +1007,8 @@ Editor::set_horizontal_position (double p)
 	horizontal_adjustment.set_value (p);
 
 	_leftmost_sample = (samplepos_t) floor (p * samples_per_pixel);
+
+	HorizontalPositionChanged (); /* EMIT SIGNAL */
 }
 
 void
@@ -82,8 +82,14 @@ struct ColumnInfo {
 
 //#define SHOW_REGION_EXTRAS
 
+/* number of queued region changes applied to the model per idle callback */
+static const size_t region_list_chunk_size = 256;
+
 EditorRegions::EditorRegions (Editor* e)
         : EditorComponent (e)
+        , _bulk_update (false)
+        , _bulk_sort_column (0)
+        , _bulk_sort_type (SORT_ASCENDING)
         , old_focus (0)
         , name_editable (0)
         , tags_editable (0)
@@ -297,6 +303,11 @@ EditorRegions::EditorRegions (Editor* e)
 	e->EditorThaw.connect (editor_thaw_connection, MISSING_INVALIDATOR, boost::bind (&EditorRegions::thaw_tree_model, this), gui_context ());
 }
 
+EditorRegions::~EditorRegions ()
+{
+	_idle_update_connection.disconnect ();
+}
+
 bool
 EditorRegions::focus_in (GdkEventFocus*)
 {
@@ -357,6 +368,8 @@ EditorRegions::set_session (ARDOUR::Session* s)
 {
 	SessionHandlePtr::set_session (s);
 
+	drop_pending_changes ();
+
 	ARDOUR::Region::RegionPropertyChanged.connect (region_property_connection, MISSING_INVALIDATOR, boost::bind (&EditorRegions::region_changed, this, _1, _2), gui_context ());
 	ARDOUR::RegionFactory::CheckNewRegion.connect (check_new_region_connection, MISSING_INVALIDATOR, boost::bind (&EditorRegions::add_region, this, _1), gui_context ());
 
@@ -388,9 +401,11 @@ EditorRegions::destroy_region (boost::shared_ptr<ARDOUR::Region> region)
 	//so this would be a no-op anyway
 	//perhaps someday we will allow users to manually destroy regions.
 	RegionRowMap::iterator map_it = region_row_map.find (region);
+	_pending_changes.erase (region);
+
 	if (map_it != region_row_map.end ()) {
-		region_row_map.erase (map_it);
 		_model->erase (map_it->second);
+		region_row_map.erase (map_it);
 	}
 }
 
@@ -422,6 +437,93 @@ EditorRegions::remove_unused_regions ()
 
 void
 EditorRegions::region_changed (boost::shared_ptr<Region> r, const PropertyChange& what_changed)
+{
+	/* coalesce with any change still waiting for the idle handler.
+	 * An empty PropertyChange means "everything", and absorbs all others.
+	 */
+	std::pair<PendingChanges::iterator, bool> res = _pending_changes.insert (make_pair (r, what_changed));
+
+	if (!res.second && !res.first->second.empty ()) {
+		if (what_changed.empty ()) {
+			res.first->second.clear ();
+		} else {
+			res.first->second.add (what_changed);
+		}
+	}
+
+	if (!_idle_update_connection.connected ()) {
+		_idle_update_connection = Glib::signal_idle ().connect (sigc::mem_fun (*this, &EditorRegions::idle_update));
+	}
+}
+
+bool
+EditorRegions::idle_update ()
+{
+	if (!_bulk_update && _pending_changes.size () > region_list_chunk_size) {
+		/* a large batch is about to trickle in; keep the model unsorted
+		 * until it is complete rather than re-sorting for every row.
+		 */
+		_model->get_sort_column_id (_bulk_sort_column, _bulk_sort_type);
+		_model->set_sort_column (-2, SORT_ASCENDING);
+		_bulk_update = true;
+	}
+
+	apply_pending_changes (region_list_chunk_size);
+
+	if (!_pending_changes.empty ()) {
+		return true;
+	}
+
+	if (_bulk_update) {
+		_model->set_sort_column (_bulk_sort_column, _bulk_sort_type);
+		_bulk_update = false;
+	}
+
+	return false;
+}
+
+void
+EditorRegions::flush_pending_changes ()
+{
+	if (_pending_changes.empty ()) {
+		return;
+	}
+
+	_idle_update_connection.disconnect ();
+	apply_pending_changes (_pending_changes.size ());
+
+	if (_bulk_update) {
+		_model->set_sort_column (_bulk_sort_column, _bulk_sort_type);
+		_bulk_update = false;
+	}
+}
+
+void
+EditorRegions::apply_pending_changes (size_t max_changes)
+{
+	while (max_changes-- > 0 && !_pending_changes.empty ()) {
+		PendingChanges::iterator i = _pending_changes.begin ();
+		boost::shared_ptr<Region> r = i->first;
+		PropertyChange what_changed = i->second;
+		_pending_changes.erase (i);
+		update_region (r, what_changed);
+	}
+}
+
+void
+EditorRegions::drop_pending_changes ()
+{
+	_idle_update_connection.disconnect ();
+	_pending_changes.clear ();
+
+	if (_bulk_update) {
+		_model->set_sort_column (_bulk_sort_column, _bulk_sort_type);
+		_bulk_update = false;
+	}
+}
+
+void
+EditorRegions::update_region (boost::shared_ptr<Region> r, const PropertyChange& what_changed)
 {
 	RegionRowMap::iterator map_it = region_row_map.find (r);
 
@@ -430,8 +532,8 @@ EditorRegions::region_changed (boost::shared_ptr<Region> r, const PropertyChange
 		/* this region is not on an active playlist
 		 * maybe it got deleted, or whatever */
 		if (map_it != region_row_map.end ()) {
-			region_row_map.erase (map_it);
 			_model->erase (map_it->second);
+			region_row_map.erase (map_it);
 		}
 		return;
 	}
@@ -491,6 +593,9 @@ EditorRegions::selection_changed ()
 void
 EditorRegions::set_selected (RegionSelection& regions)
 {
+	/* rows for recently added regions may not exist yet */
+	flush_pending_changes ();
+
 	for (RegionSelection::iterator i = regions.begin (); i != regions.end (); ++i) {
 		boost::shared_ptr<Region> r ((*i)->region ());
 
@@ -512,22 +617,25 @@ EditorRegions::redisplay ()
 		return;
 	}
 
-	/* store sort column id and type for later */
-	int sort_col_id;
-	Gtk::SortType sort_type;
-	_model->get_sort_column_id (sort_col_id, sort_type);
-
-	_display.set_model (Glib::RefPtr<Gtk::TreeStore> (0));
-	_model->clear ();
-	/* Disable sorting to gain performance */
-	_model->set_sort_column (-2, SORT_ASCENDING);
-
-	region_row_map.clear ();
+	/* diff against the current model rather than rebuilding it:
+	 * rows of regions that no longer exist are removed right away,
+	 * everything else is (re)queued and applied from the idle handler.
+	 */
+	RegionFactory::RegionMap const regions (RegionFactory::all_regions ());
 
-	RegionFactory::foreach_region (sigc::mem_fun (*this, &EditorRegions::add_region));
+	for (RegionRowMap::iterator i = region_row_map.begin (); i != region_row_map.end ();) {
+		if (regions.find (i->first->id ()) == regions.end ()) {
+			_pending_changes.erase (i->first);
+			_model->erase (i->second);
+			region_row_map.erase (i++);
+		} else {
+			++i;
+		}
+	}
 
-	_model->set_sort_column (sort_col_id, sort_type); // re-enabale sorting
-	_display.set_model (_model);
+	for (RegionFactory::RegionMap::const_iterator i = regions.begin (); i != regions.end (); ++i) {
+		add_region (i->second);
+	}
 }
 
 void
@@ -1137,6 +1245,8 @@ EditorRegions::get_dragged_region ()
 void
 EditorRegions::clear ()
 {
+	drop_pending_changes ();
+
 	_display.set_model (Glib::RefPtr<Gtk::TreeStore> (0));
 	_model->clear ();
 	_display.set_model (_model);
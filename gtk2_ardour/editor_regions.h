@@ -21,6 +21,8 @@
 #ifndef __gtk_ardour_editor_regions_h__
 #define __gtk_ardour_editor_regions_h__
 
+#include <map>
+
 #include <boost/unordered_map.hpp>
 
 #include <gtkmm/scrolledwindow.h>
@@ -34,6 +36,7 @@ class EditorRegions : public EditorComponent, public ARDOUR::SessionHandlePtr
 {
 public:
 	EditorRegions (Editor *);
+	~EditorRegions ();
 
 	void set_session (ARDOUR::Session *);
 
@@ -120,8 +123,26 @@ private:
 	void freeze_tree_model ();
 	void thaw_tree_model ();
 	void region_changed (boost::shared_ptr<ARDOUR::Region>, PBD::PropertyChange const &);
+	void update_region (boost::shared_ptr<ARDOUR::Region>, PBD::PropertyChange const &);
 	void selection_changed ();
 
+	/* model updates are coalesced per region and applied in chunks
+	 * from an idle callback, so that bulk imports or session loads
+	 * do not block the GUI while the list is (re)built.
+	 */
+	typedef std::map<boost::shared_ptr<ARDOUR::Region>, PBD::PropertyChange> PendingChanges;
+
+	PendingChanges   _pending_changes;
+	sigc::connection _idle_update_connection;
+	bool             _bulk_update;
+	int              _bulk_sort_column;
+	Gtk::SortType    _bulk_sort_type;
+
+	bool idle_update ();
+	void flush_pending_changes ();
+	void apply_pending_changes (size_t max_changes);
+	void drop_pending_changes ();
+
 	sigc::connection _change_connection;
 
 	bool selection_filter (const Glib::RefPtr<Gtk::TreeModel>& model, const Gtk::TreeModel::Path& path, bool yn);
@@ -77,10 +77,14 @@ struct ColumnInfo {
 	const char* tooltip;
 };
 
+/* number of queued sources appended to the model per idle callback */
+static const size_t source_list_chunk_size = 256;
+
 EditorSources::EditorSources (Editor* e)
 	: EditorComponent (e)
 	, old_focus (0)
 	, tags_editable (0)
+	, _bulk_update (false)
 {
 	_display.set_size_request (100, -1);
 	_display.set_rules_hint (true);
@@ -218,6 +222,11 @@ EditorSources::EditorSources (Editor* e)
 	e->EditorThaw.connect (editor_thaw_connection, MISSING_INVALIDATOR, boost::bind (&EditorSources::thaw_tree_model, this), gui_context());
 }
 
+EditorSources::~EditorSources ()
+{
+	_idle_update_connection.disconnect ();
+}
+
 bool
 EditorSources::focus_in (GdkEventFocus*)
 {
@@ -300,12 +309,18 @@ EditorSources::remove_weak_source (boost::weak_ptr<ARDOUR::Source> src)
 void
 EditorSources::remove_source (boost::shared_ptr<ARDOUR::Source> source)
 {
-	TreeModel::iterator i;
-	TreeModel::Children rows = _model->children();
-	for (i = rows.begin(); i != rows.end(); ++i) {
-		boost::shared_ptr<ARDOUR::Region> rr = (*i)[_columns.region];
-		if (rr->source() == source) {
-			_model->erase(i);
+	for (std::set<boost::shared_ptr<Region> >::iterator i = _pending_sources.begin (); i != _pending_sources.end ();) {
+		if ((*i)->source() == source) {
+			_pending_sources.erase (i++);
+		} else {
+			++i;
+		}
+	}
+
+	for (RegionRowMap::iterator i = region_row_map.begin(); i != region_row_map.end(); ++i) {
+		if (i->first->source() == source) {
+			_model->erase (i->second);
+			region_row_map.erase (i);
 			break;
 		}
 	}
@@ -318,13 +333,13 @@ EditorSources::remove_weak_region (boost::weak_ptr<ARDOUR::Region> r)
 	if (!region) {
 		return;
 	}
-	TreeModel::Children rows = _model->children();
-	for (TreeModel::iterator i = rows.begin(); i != rows.end(); ++i) {
-		boost::shared_ptr<ARDOUR::Region> rr = (*i)[_columns.region];
-		if (rr == region) {
-			_model->erase(i);
-			break;
-		}
+
+	_pending_sources.erase (region);
+
+	RegionRowMap::iterator i = region_row_map.find (region);
+	if (i != region_row_map.end()) {
+		_model->erase (i->second);
+		region_row_map.erase (i);
 	}
 }
 
@@ -412,16 +427,24 @@ EditorSources::populate_row (TreeModel::Row row, boost::shared_ptr<ARDOUR::Regio
 void
 EditorSources::redisplay ()
 {
-	remove_region_connections.drop_connections ();
-	_display.set_model (Glib::RefPtr<Gtk::TreeStore>(0));
-	_model->clear ();
-	_model->set_sort_column (-2, SORT_ASCENDING); // Disable sorting to gain performance
+	/* diff against the current model rather than rebuilding it:
+	 * rows of regions that no longer exist are removed right away,
+	 * missing ones are queued and appended from the idle handler.
+	 */
+	RegionFactory::RegionMap const regions (RegionFactory::all_regions ());
 
-	/* Ask the region factory to fill our list of whole-file regions */
-	RegionFactory::foreach_region (sigc::mem_fun (*this, &EditorSources::add_source));
+	for (RegionRowMap::iterator i = region_row_map.begin(); i != region_row_map.end();) {
+		if (regions.find (i->first->id()) == regions.end()) {
+			_model->erase (i->second);
+			region_row_map.erase (i++);
+		} else {
+			++i;
+		}
+	}
 
-	_model->set_sort_column (0, SORT_ASCENDING); // re-enable sorting
-	_display.set_model (_model);
+	for (RegionFactory::RegionMap::const_iterator i = regions.begin(); i != regions.end(); ++i) {
+		add_source (i->second);
+	}
 }
 
 void
@@ -439,6 +462,58 @@ EditorSources::add_source (boost::shared_ptr<ARDOUR::Region> region)
 		return;
 	}
 
+	if (region_row_map.find (region) != region_row_map.end()) {
+		return;
+	}
+
+	_pending_sources.insert (region);
+
+	if (!_idle_update_connection.connected ()) {
+		_idle_update_connection = Glib::signal_idle().connect (sigc::mem_fun (*this, &EditorSources::idle_update));
+	}
+}
+
+bool
+EditorSources::idle_update ()
+{
+	if (!_bulk_update && _pending_sources.size() > source_list_chunk_size) {
+		_model->set_sort_column (-2, SORT_ASCENDING); // Disable sorting until the batch is complete
+		_bulk_update = true;
+	}
+
+	for (size_t n = 0; n < source_list_chunk_size && !_pending_sources.empty(); ++n) {
+		boost::shared_ptr<ARDOUR::Region> region = *_pending_sources.begin();
+		_pending_sources.erase (_pending_sources.begin());
+		insert_source (region);
+	}
+
+	if (!_pending_sources.empty()) {
+		return true;
+	}
+
+	if (_bulk_update) {
+		_model->set_sort_column (0, SORT_ASCENDING); // re-enable sorting
+		_bulk_update = false;
+	}
+
+	return false;
+}
+
+void
+EditorSources::drop_pending_sources ()
+{
+	_idle_update_connection.disconnect ();
+	_pending_sources.clear ();
+
+	if (_bulk_update) {
+		_model->set_sort_column (0, SORT_ASCENDING); // re-enable sorting
+		_bulk_update = false;
+	}
+}
+
+void
+EditorSources::insert_source (boost::shared_ptr<ARDOUR::Region> region)
+{
 	/* we only show files-on-disk.
 	 * if there's some other kind of source, we ignore it (for now)
 	 */
@@ -449,8 +524,9 @@ EditorSources::add_source (boost::shared_ptr<ARDOUR::Region> region)
 
 	region->DropReferences.connect (remove_region_connections, MISSING_INVALIDATOR, boost::bind (&EditorSources::remove_weak_region, this, boost::weak_ptr<Region> (region)), gui_context());
 
-	TreeModel::Row row = *(_model->append());
-	populate_row (row, region);
+	TreeModel::iterator iter = _model->append();
+	region_row_map.insert (make_pair (region, iter));
+	populate_row (*iter, region);
 }
 
 void
@@ -458,15 +534,9 @@ EditorSources::source_changed (boost::shared_ptr<ARDOUR::Region> region)
 {
 	/* Currently never reached .. we have no mutable properties shown in the list*/
 
-	TreeModel::iterator i;
-	TreeModel::Children rows = _model->children();
-
-	for (i = rows.begin(); i != rows.end(); ++i) {
-		boost::shared_ptr<ARDOUR::Region> rr = (*i)[_columns.region];
-		if (region == rr) {
-			populate_row(*i, region);
-			break;
-		}
+	RegionRowMap::iterator i = region_row_map.find (region);
+	if (i != region_row_map.end()) {
+		populate_row (*(i->second), region);
 	}
 }
 
@@ -813,10 +883,12 @@ EditorSources::get_dragged_region ()
 void
 EditorSources::clear ()
 {
+	drop_pending_sources ();
 	remove_region_connections.drop_connections ();
 	_display.set_model (Glib::RefPtr<Gtk::TreeStore> (0));
 	_model->clear ();
 	_display.set_model (_model);
+	region_row_map.clear ();
 }
 
 boost::shared_ptr<ARDOUR::Region>
@@ -18,6 +18,8 @@
 #ifndef __gtk_ardour_editor_sources_h__
 #define __gtk_ardour_editor_sources_h__
 
+#include <set>
+
 #include <boost/unordered_map.hpp>
 
 #include <gtkmm/scrolledwindow.h>
@@ -33,6 +35,7 @@ class EditorSources : public EditorComponent, public ARDOUR::SessionHandlePtr
 {
 public:
 	EditorSources (Editor *);
+	~EditorSources ();
 
 	void set_session (ARDOUR::Session *);
 
@@ -111,6 +114,7 @@ private:
 	void format_position (ARDOUR::samplepos_t pos, char* buf, size_t bufsize, bool onoff = true);
 
 	void add_source (boost::shared_ptr<ARDOUR::Region>);
+	void insert_source (boost::shared_ptr<ARDOUR::Region>);
 	void remove_source (boost::shared_ptr<ARDOUR::Source>);
 	void remove_weak_region (boost::weak_ptr<ARDOUR::Region>);
 	void remove_weak_source (boost::weak_ptr<ARDOUR::Source>);
@@ -119,6 +123,12 @@ private:
 
 	void redisplay ();
 
+	/* new rows are queued and appended in chunks from an idle callback,
+	 * so that importing many files does not block the GUI.
+	 */
+	bool idle_update ();
+	void drop_pending_sources ();
+
 	void drag_data_received (
 		Glib::RefPtr<Gdk::DragContext> const &, gint, gint, Gtk::SelectionData const &, guint, guint
 		);
@@ -129,6 +139,14 @@ private:
 
 	Glib::RefPtr<Gtk::TreeStore> _model;
 
+	typedef boost::unordered_map<boost::shared_ptr<ARDOUR::Region>, Gtk::TreeModel::iterator> RegionRowMap;
+
+	RegionRowMap region_row_map;
+
+	std::set<boost::shared_ptr<ARDOUR::Region> > _pending_sources;
+	sigc::connection _idle_update_connection;
+	bool             _bulk_update;
+
 	PBD::ScopedConnection add_source_connection;
 	PBD::ScopedConnection remove_source_connection;
 	PBD::ScopedConnectionList remove_region_connections;
@@ -29,6 +29,7 @@
 #include "ardour/parameter_descriptor.h"
 
 #include "canvas/container.h"
+#include "canvas/note_set.h"
 #include "canvas/polygon.h"
 #include "canvas/rectangle.h"
 #include "canvas/debug.h"
@@ -190,6 +191,7 @@ MidiGhostRegion::MidiGhostRegion(MidiRegionView& rv,
                                  double initial_unit_pos)
 	: GhostRegion(rv, tv.ghost_group(), tv, source_tv, initial_unit_pos)
 	, _note_group (new ArdourCanvas::Container (group))
+	, _note_set (0)
 	,  parent_mrv (rv)
 	, _optimization_iterator(events.end())
 {
@@ -213,6 +215,7 @@ MidiGhostRegion::MidiGhostRegion(MidiRegionView& rv,
 	               source_tv,
 	               initial_unit_pos)
 	, _note_group (new ArdourCanvas::Container (group))
+	, _note_set (0)
 	, parent_mrv (rv)
 	, _optimization_iterator(events.end())
 {
@@ -290,6 +293,8 @@ MidiGhostRegion::set_colors()
 		it->second->item->set_fill_color (UIConfiguration::instance().color_mod((*it).second->event->base_color(), "ghost track midi fill"));
 		it->second->item->set_outline_color (_outline);
 	}
+
+	redisplay_note_set ();
 }
 
 static double
@@ -338,6 +343,8 @@ MidiGhostRegion::update_contents_height ()
 			_tmp_poly->set(Hit::points(h));
 		}
 	}
+
+	redisplay_note_set ();
 }
 
 void
@@ -376,6 +383,8 @@ MidiGhostRegion::add_note (NoteBase* n)
 void
 MidiGhostRegion::clear_events()
 {
+	/* the note set is a child of _note_group */
+	_note_set = 0;
 	_note_group->clear (true);
 	events.clear ();
 	_optimization_iterator = events.end();
@@ -466,6 +475,52 @@ MidiGhostRegion::redisplay_model ()
 
 		++i;
 	}
+
+	redisplay_note_set ();
+}
+
+/** Draw the notes that our parent draws with its note set, taking them
+ *  from the model rather than from canvas notes (which they do not have).
+ */
+void
+MidiGhostRegion::redisplay_note_set ()
+{
+	std::vector<boost::shared_ptr<NoteType> > const & notes (parent_mrv._note_set_notes);
+
+	if (notes.empty()) {
+		if (_note_set) {
+			_note_set->clear ();
+		}
+		return;
+	}
+
+	MidiStreamView* mv = midi_view();
+
+	if (!mv) {
+		return;
+	}
+
+	if (!_note_set) {
+		_note_set = new ArdourCanvas::NoteSet (_note_group);
+		CANVAS_DEBUG_NAME (_note_set, "ghost note set");
+		_note_set->set_ignore_events (true);
+		_note_set->lower_to_bottom ();
+	}
+
+	double const h = note_height(trackview, mv);
+	ArdourCanvas::NoteSet::Notes set_notes;
+
+	set_notes.reserve (notes.size());
+
+	for (uint32_t n = 0; n < notes.size(); ++n) {
+		ArdourCanvas::Rect const r (parent_mrv.sustained_note_rect (notes[n]));
+		double const y = note_y(trackview, mv, notes[n]->note());
+		Gtkmm2ext::Color const fill = UIConfiguration::instance().color_mod (NoteBase::base_color (parent_mrv, *notes[n], false), "ghost track midi fill");
+
+		set_notes.push_back (ArdourCanvas::NoteSet::Note (ArdourCanvas::Rect (r.x0, y, r.x1, y + h), fill, _outline, n));
+	}
+
+	_note_set->set (set_notes);
 }
 
 /** Given a note in our parent region (ie the actual MidiRegionView), find our
@@ -126,7 +126,11 @@ public:
 	void clear_events();
 
 private:
+	void redisplay_note_set ();
+
 	ArdourCanvas::Container* _note_group;
+	/** draws the notes that the parent draws with its note set */
+	ArdourCanvas::NoteSet* _note_set;
 	Gtkmm2ext::Color _outline;
 	ArdourCanvas::Rectangle* _tmp_rect;
 	ArdourCanvas::Polygon* _tmp_poly;
@@ -139,9 +139,27 @@ LevelMeterBase::update_meters ()
 
 	uint32_t nmidi = _meter->input_streams().n_midi();
 
+	/* fetch all channels at once, fall back to per-channel queries
+	 * if the meter has no valid snapshot (inactive, or being reset) */
+	MeterType meter_type = _meter->meter_type ();
+	const bool snapshot = _meter->read_levels (levels, meter_type);
+
 	for (n = 0, i = meters.begin(); i != meters.end(); ++i, ++n) {
 		if ((*i).packed) {
-			const float mpeak = _meter->meter_level(n, MeterMaxPeak);
+			float mpeak, peak, dpm;
+			if (snapshot) {
+				if (n >= levels.size ()) {
+					continue;
+				}
+				mpeak = levels[n].max_peak;
+				dpm   = levels[n].peak;
+				peak  = levels[n].level;
+			} else {
+				mpeak = _meter->meter_level (n, MeterMaxPeak);
+				dpm   = _meter->meter_level (n, MeterPeak);
+				peak  = n < nmidi ? dpm : _meter->meter_level (n, meter_type);
+			}
+
 			if (mpeak > (*i).max_peak) {
 				(*i).max_peak = mpeak;
 				(*i).meter->set_highlight(mpeak >= UIConfiguration::instance().get_meter_peak());
@@ -151,10 +169,8 @@ LevelMeterBase::update_meters ()
 			}
 
 			if (n < nmidi) {
-				(*i).meter->set (_meter->meter_level (n, MeterPeak));
+				(*i).meter->set (dpm);
 			} else {
-				MeterType meter_type = _meter->meter_type ();
-				const float peak = _meter->meter_level (n, meter_type);
 				if (meter_type == MeterPeak) {
 					(*i).meter->set (log_meter (peak));
 				} else if (meter_type == MeterPeak0dB) {
@@ -168,13 +184,13 @@ LevelMeterBase::update_meters ()
 				} else if (meter_type == MeterVU) {
 					(*i).meter->set (meter_deflect_vu (peak + vu_standard() + meter_lineup(0)));
 				} else if (meter_type == MeterK12) {
-					(*i).meter->set (meter_deflect_k (peak, 12), meter_deflect_k(_meter->meter_level(n, MeterPeak), 12));
+					(*i).meter->set (meter_deflect_k (peak, 12), meter_deflect_k (dpm, 12));
 				} else if (meter_type == MeterK14) {
-					(*i).meter->set (meter_deflect_k (peak, 14), meter_deflect_k(_meter->meter_level(n, MeterPeak), 14));
+					(*i).meter->set (meter_deflect_k (peak, 14), meter_deflect_k (dpm, 14));
 				} else if (meter_type == MeterK20) {
-					(*i).meter->set (meter_deflect_k (peak, 20), meter_deflect_k(_meter->meter_level(n, MeterPeak), 20));
+					(*i).meter->set (meter_deflect_k (peak, 20), meter_deflect_k (dpm, 20));
 				} else { // RMS
-					(*i).meter->set (log_meter (peak), log_meter(_meter->meter_level(n, MeterPeak)));
+					(*i).meter->set (log_meter (peak), log_meter (dpm));
 				}
 			}
 		}
@@ -34,6 +34,7 @@
 
 #include "ardour/types.h"
 #include "ardour/chan_count.h"
+#include "ardour/meter.h"
 #include "ardour/session_handle.h"
 
 #include "widgets/fastmeter.h"
@@ -104,6 +105,7 @@ private:
 	guint16                thin_meter_width;
 	std::vector<MeterInfo> meters;
 	float                  max_peak;
+	std::vector<ARDOUR::PeakMeter::Levels> levels;
 	ARDOUR::MeterType      visible_meter_type;
 	uint32_t               midi_count;
 	uint32_t               meter_count;
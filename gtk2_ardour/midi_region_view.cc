@@ -54,6 +54,7 @@
 #include "evoral/midi_util.h"
 
 #include "canvas/debug.h"
+#include "canvas/note_set.h"
 #include "canvas/text.h"
 
 #include "automation_region_view.h"
@@ -113,6 +114,8 @@ MidiRegionView::MidiRegionView (ArdourCanvas::Container*      parent,
 	, _region_relative_time_converter_double(r->session().tempo_map(), r->position())
 	, _active_notes(0)
 	, _note_group (new ArdourCanvas::Container (group))
+	, _note_set (0)
+	, _note_set_n_selected (0)
 	, _note_diff_command (0)
 	, _ghost_note(0)
 	, _step_edit_cursor (0)
@@ -160,6 +163,8 @@ MidiRegionView::MidiRegionView (ArdourCanvas::Container*      parent,
 	, _region_relative_time_converter_double(r->session().tempo_map(), r->position())
 	, _active_notes(0)
 	, _note_group (new ArdourCanvas::Container (group))
+	, _note_set (0)
+	, _note_set_n_selected (0)
 	, _note_diff_command (0)
 	, _ghost_note(0)
 	, _step_edit_cursor (0)
@@ -214,6 +219,8 @@ MidiRegionView::MidiRegionView (const MidiRegionView& other)
 	, _region_relative_time_converter_double(other.region_relative_time_converter_double())
 	, _active_notes(0)
 	, _note_group (new ArdourCanvas::Container (get_canvas_group()))
+	, _note_set (0)
+	, _note_set_n_selected (0)
 	, _note_diff_command (0)
 	, _ghost_note(0)
 	, _step_edit_cursor (0)
@@ -244,6 +251,8 @@ MidiRegionView::MidiRegionView (const MidiRegionView& other, boost::shared_ptr<M
 	, _region_relative_time_converter_double(other.region_relative_time_converter_double())
 	, _active_notes(0)
 	, _note_group (new ArdourCanvas::Container (get_canvas_group()))
+	, _note_set (0)
+	, _note_set_n_selected (0)
 	, _note_diff_command (0)
 	, _ghost_note(0)
 	, _step_edit_cursor (0)
@@ -514,6 +523,27 @@ MidiRegionView::button_press (GdkEventButton* ev)
 		_press_cursor_ctx = CursorContext::create(*editor, editor->cursors()->midi_pencil);
 	}
 
+	if (m == MouseContent && _note_set && _mouse_state != SelectTouchDragging &&
+	    !Keyboard::modifier_state_contains (ev->state, Keyboard::insert_note_modifier())) {
+
+		/* notes drawn by the note set have no canvas item to receive
+		 * the click, so give the note under the pointer one now, and
+		 * pass the press on to it, to select it and start a note drag
+		 * or resize as if it had been clicked directly.
+		 */
+
+		double x = ev->x;
+		double y = ev->y;
+		_note_set->canvas_to_item (x, y);
+
+		const int32_t n = _note_set->note_at (ArdourCanvas::Duple (x, y));
+
+		if (n >= 0) {
+			NoteBase* cne = materialize_note (n);
+			return cne->item()->Event ((GdkEvent*) ev);
+		}
+	}
+
 	if (_mouse_state != SelectTouchDragging) {
 
 		_pressed_button = ev->button;
@@ -701,7 +731,7 @@ MidiRegionView::scroll (GdkEventScroll* ev)
 	if (trackview.editor().drags()->active()) {
 		return false;
 	}
-	if (_selection.empty()) {
+	if (selection_size() == 0) {
 		return false;
 	}
 
@@ -764,6 +794,8 @@ MidiRegionView::key_release (GdkEventKey* ev)
 void
 MidiRegionView::channel_edit ()
 {
+	materialize_selection ();
+
 	if (_selection.empty()) {
 		return;
 	}
@@ -800,6 +832,8 @@ MidiRegionView::channel_edit ()
 void
 MidiRegionView::velocity_edit ()
 {
+	materialize_selection ();
+
 	if (_selection.empty()) {
 		return;
 	}
@@ -903,6 +937,12 @@ MidiRegionView::clear_events ()
 	}
 
 
+	/* the note set is a child of _note_group */
+	_note_set = 0;
+	_note_set_notes.clear ();
+	_note_set_selected.clear ();
+	_note_set_n_selected = 0;
+
 	_note_group->clear (true);
 	_events.clear();
 	_patch_changes.clear();
@@ -1120,6 +1160,48 @@ MidiRegionView::redisplay_model()
 		return;
 	}
 
+	MidiModel::ReadLock lock(_model->read_lock());
+
+	if (use_note_set ()) {
+		redisplay_note_set ();
+	} else {
+		if (_note_set) {
+			/* keep the selection of notes which now get canvas items */
+			for (uint32_t n = 0; _note_set_n_selected > 0 && n < _note_set_notes.size(); ++n) {
+				if (_note_set_selected[n]) {
+					_pending_note_selection.insert (_note_set_notes[n]->id());
+				}
+			}
+			_note_set->clear ();
+			_note_set_notes.clear ();
+			_note_set_selected.clear ();
+			_note_set_n_selected = 0;
+		}
+		redisplay_note_items ();
+	}
+
+	for (vector<GhostRegion*>::iterator j = ghosts.begin(); j != ghosts.end(); ++j) {
+		MidiGhostRegion* gr = dynamic_cast<MidiGhostRegion*> (*j);
+		if (gr && !gr->trackview.hidden()) {
+			gr->redisplay_model ();
+		}
+	}
+
+	display_sysexes();
+	display_patch_changes ();
+
+	_marked_for_selection.clear ();
+	_marked_for_velocity.clear ();
+	_pending_note_selection.clear ();
+
+}
+
+/** Create or update one canvas item per note in the model.
+ *  Called with the model read lock held.
+ */
+void
+MidiRegionView::redisplay_note_items ()
+{
 	for (_optimization_iterator = _events.begin(); _optimization_iterator != _events.end(); ++_optimization_iterator) {
 		_optimization_iterator->second->invalidate();
 	}
@@ -1130,7 +1212,6 @@ MidiRegionView::redisplay_model()
 	Note* sus = NULL;
 	Hit*  hit = NULL;
 
-	MidiModel::ReadLock lock(_model->read_lock());
 	MidiModel::Notes& notes (_model->notes());
 
 	NoteBase* cne;
@@ -1214,21 +1295,234 @@ MidiRegionView::redisplay_model()
 			}
 		}
 	}
+}
 
-	for (vector<GhostRegion*>::iterator j = ghosts.begin(); j != ghosts.end(); ++j) {
-		MidiGhostRegion* gr = dynamic_cast<MidiGhostRegion*> (*j);
-		if (gr && !gr->trackview.hidden()) {
-			gr->redisplay_model ();
+bool
+MidiRegionView::use_note_set () const
+{
+	/* the note set only draws sustained notes, and is not used while
+	 * recording, when notes are extended one by one.
+	 */
+	return !_active_notes &&
+		midi_view()->note_mode() == Sustained &&
+		_model->notes().size() > UIConfiguration::instance().get_max_note_items();
+}
+
+/** Draw all notes with a single NoteSet item, keeping canvas items only
+ *  for notes that are (or are about to be) selected.
+ *  Called with the model read lock held.
+ */
+void
+MidiRegionView::redisplay_note_set ()
+{
+	if (!_note_set) {
+		_note_set = new ArdourCanvas::NoteSet (_note_group);
+		CANVAS_DEBUG_NAME (_note_set, string_compose ("note set for %1", get_item_name()));
+		/* events go to the region, see ::button_press() */
+		_note_set->set_ignore_events (true);
+		_note_set->lower_to_bottom ();
+	}
+
+	for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
+		i->second->invalidate ();
+	}
+
+	/* notes selected in the note set stay selected */
+	std::set<boost::shared_ptr<NoteType> > selected;
+
+	for (uint32_t n = 0; _note_set_n_selected > 0 && n < _note_set_notes.size(); ++n) {
+		if (_note_set_selected[n]) {
+			selected.insert (_note_set_notes[n]);
 		}
 	}
 
-	display_sysexes();
-	display_patch_changes ();
+	MidiModel::Notes& notes (_model->notes());
+	ArdourCanvas::NoteSet::Notes set_notes;
 
-	_marked_for_selection.clear ();
-	_marked_for_velocity.clear ();
-	_pending_note_selection.clear ();
+	set_notes.reserve (notes.size());
+	_note_set_notes.clear ();
+	_note_set_selected.clear ();
+	_note_set_n_selected = 0;
+
+	for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
+
+		boost::shared_ptr<NoteType> note (*n);
+		bool visible;
+
+		if (!note_in_region_range (note, visible)) {
+			continue;
+		}
+
+		const bool pending = _pending_note_selection.find (note->id()) != _pending_note_selection.end();
+		const bool wanted = pending || _marked_for_selection.find (note) != _marked_for_selection.end();
+
+		Events::iterator e = _events.find (note);
+
+		if (e != _events.end() && (e->second->selected() || wanted)) {
+			NoteBase* cne = e->second;
+			cne->validate ();
+			if (visible) {
+				cne->show ();
+				update_note (cne);
+			} else {
+				cne->hide ();
+			}
+			continue;
+		}
+
+		if (wanted) {
+			NoteBase* cne = add_note (note, visible);
+			if (pending) {
+				add_to_selection (cne);
+			}
+			continue;
+		}
+
+		const bool sel = !selected.empty() && selected.find (note) != selected.end();
+
+		if (!visible) {
+			if (sel) {
+				/* hidden notes are not drawn by the note set */
+				NoteBase* cne = add_note (note, false);
+				_selection.insert (cne);
+				cne->set_selected (true);
+			}
+			continue;
+		}
+
+		const uint32_t col = NoteBase::base_color (*this, *note, sel);
+
+		set_notes.push_back (ArdourCanvas::NoteSet::Note (sustained_note_rect (note), col, NoteBase::calculate_outline (col, sel), _note_set_notes.size()));
+		_note_set_notes.push_back (note);
+		_note_set_selected.push_back (sel);
+
+		if (sel) {
+			++_note_set_n_selected;
+		}
+	}
+
+	/* drop canvas notes that are no longer selected, or no longer exist */
+
+	for (Events::iterator i = _events.begin(); i != _events.end(); ) {
+
+		NoteBase* cne = i->second;
+
+		if (cne->valid()) {
+			++i;
+			continue;
+		}
+
+		for (vector<GhostRegion*>::iterator j = ghosts.begin(); j != ghosts.end(); ++j) {
+			MidiGhostRegion* gr = dynamic_cast<MidiGhostRegion*> (*j);
+			if (gr) {
+				gr->remove_note (cne);
+			}
+		}
+
+		if (_entered_note == cne) {
+			_entered_note = 0;
+		}
+
+		delete cne;
+		i = _events.erase (i);
+	}
+
+	_optimization_iterator = _events.end();
+
+	_note_set->set (set_notes);
+}
+
+/** Give a note drawn by the note set a canvas item of its own,
+ *  so that it can be selected and edited.
+ *  @param n Index into _note_set_notes.
+ */
+NoteBase*
+MidiRegionView::materialize_note (uint32_t n)
+{
+	boost::shared_ptr<NoteType> note (_note_set_notes[n]);
+	Events::iterator e = _events.find (note);
+	NoteBase* cne = (e != _events.end()) ? e->second : add_note (note, true);
+
+	if (_note_set_selected[n]) {
+		/* the canvas note takes over the selection */
+		_note_set_selected[n] = false;
+		--_note_set_n_selected;
+		_selection.insert (cne);
+		cne->set_selected (true);
+	}
+
+	return cne;
+}
+
+/** Materialize all notes drawn by the note set within \p r (in region coordinates) */
+void
+MidiRegionView::materialize_notes (ArdourCanvas::Rect const & r)
+{
+	if (!_note_set) {
+		return;
+	}
+
+	std::vector<uint32_t> indices;
+	_note_set->notes_in (r, indices);
+
+	for (std::vector<uint32_t>::const_iterator i = indices.begin(); i != indices.end(); ++i) {
+		materialize_note (*i);
+	}
+}
+
+/** Materialize the notes selected in the note set, so that the whole
+ *  selection is in _selection, before it is edited.
+ */
+void
+MidiRegionView::materialize_selection ()
+{
+	for (uint32_t n = 0; _note_set_n_selected > 0 && n < _note_set_notes.size(); ++n) {
+		if (_note_set_selected[n]) {
+			materialize_note (n);
+		}
+	}
+}
+
+void
+MidiRegionView::select_note_set_note (uint32_t n, bool yn)
+{
+	if (_note_set_selected[n] == yn) {
+		return;
+	}
+
+	if (yn) {
+		if (_selection.empty() && _note_set_n_selected == 0) {
+			trackview.editor().set_selected_midi_region_view (*this);
+		}
+		++_note_set_n_selected;
+	} else {
+		--_note_set_n_selected;
+	}
+
+	_note_set_selected[n] = yn;
+}
+
+/** Show the selection state of the notes drawn by the note set */
+void
+MidiRegionView::refresh_note_set ()
+{
+	if (!_note_set) {
+		return;
+	}
+
+	std::vector<Gtkmm2ext::Color> fill;
+	std::vector<Gtkmm2ext::Color> outline;
+
+	fill.reserve (_note_set_notes.size());
+	outline.reserve (_note_set_notes.size());
+
+	for (uint32_t n = 0; n < _note_set_notes.size(); ++n) {
+		const uint32_t col = NoteBase::base_color (*this, *_note_set_notes[n], _note_set_selected[n]);
+		fill.push_back (col);
+		outline.push_back (NoteBase::calculate_outline (col, _note_set_selected[n]));
+	}
 
+	_note_set->set_colors (fill, outline);
 }
 
 void
@@ -1652,12 +1946,12 @@ MidiRegionView::update_note (NoteBase* note, bool update_ghost_regions)
  *  @param ev Canvas note to update.
  *  @param update_ghost_regions true to update the note in any ghost regions that we have, otherwise false.
  */
-void
-MidiRegionView::update_sustained (Note* ev, bool update_ghost_regions)
+/** @return the rectangle (in region coordinates) a sustained note is drawn in */
+ArdourCanvas::Rect
+MidiRegionView::sustained_note_rect (boost::shared_ptr<NoteType> note)
 {
 	TempoMap& map (trackview.session()->tempo_map());
 	const boost::shared_ptr<ARDOUR::MidiRegion> mr = midi_region();
-	boost::shared_ptr<NoteType> note = ev->note();
 
 	const double session_source_start = _region->quarter_note() - mr->start_beats();
 	const samplepos_t note_start_samples = map.sample_at_quarter_note (note->time().to_double() + session_source_start) - _region->position();
@@ -1696,7 +1990,17 @@ MidiRegionView::update_sustained (Note* ev, bool update_ghost_regions)
 
 	y1 = y0 + std::max(1., floor(note_height()) - 1);
 
-	ev->set (ArdourCanvas::Rect (x0, y0, x1, y1));
+
+	return ArdourCanvas::Rect (x0, y0, x1, y1);
+}
+
+void
+MidiRegionView::update_sustained (Note* ev, bool update_ghost_regions)
+{
+	boost::shared_ptr<NoteType> note = ev->note();
+	const ArdourCanvas::Rect r (sustained_note_rect (note));
+
+	ev->set (r);
 	ev->set_velocity (note->velocity()/127.0);
 
 	if (note->end_time() == std::numeric_limits<Temporal::Beats>::max())  {
@@ -1705,7 +2009,7 @@ MidiRegionView::update_sustained (Note* ev, bool update_ghost_regions)
 			if (old_rect) {
 				/* There is an active note on this key, so we have a stuck
 				   note.  Finish the old rectangle here. */
-				old_rect->set_x1 (x1);
+				old_rect->set_x1 (r.x1);
 				old_rect->set_outline_all ();
 			}
 			_active_notes[note->note()] = ev;
@@ -2090,6 +2394,8 @@ MidiRegionView::note_deleted (NoteBase* cne)
 void
 MidiRegionView::delete_selection()
 {
+	materialize_selection ();
+
 	if (_selection.empty()) {
 		return;
 	}
@@ -2142,6 +2448,12 @@ MidiRegionView::clear_selection_internal ()
 		(*i)->hide_velocity();
 	}
 	_selection.clear();
+
+	if (_note_set_n_selected > 0) {
+		_note_set_selected.assign (_note_set_selected.size(), false);
+		_note_set_n_selected = 0;
+		refresh_note_set ();
+	}
 }
 
 void
@@ -2157,6 +2469,12 @@ MidiRegionView::select_all_notes ()
 	for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
 		add_to_selection (i->second);
 	}
+
+	for (uint32_t n = 0; n < _note_set_notes.size(); ++n) {
+		select_note_set_note (n, true);
+	}
+
+	refresh_note_set ();
 }
 
 void
@@ -2168,11 +2486,26 @@ MidiRegionView::select_range (samplepos_t start, samplepos_t end)
 			add_to_selection (i->second);
 		}
 	}
+
+	for (uint32_t n = 0; n < _note_set_notes.size(); ++n) {
+		samplepos_t t = source_beats_to_absolute_samples(_note_set_notes[n]->time());
+		if (t >= start && t <= end) {
+			select_note_set_note (n, true);
+		}
+	}
+
+	refresh_note_set ();
 }
 
 void
 MidiRegionView::invert_selection ()
 {
+	/* note set notes first, so that removing the last canvas note
+	 * does not drop the region from the editor selection */
+	for (uint32_t n = 0; n < _note_set_notes.size(); ++n) {
+		select_note_set_note (n, !_note_set_selected[n]);
+	}
+
 	for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
 		if (i->second->selected()) {
 			remove_from_selection(i->second);
@@ -2180,6 +2513,12 @@ MidiRegionView::invert_selection ()
 			add_to_selection (i->second);
 		}
 	}
+
+	if (_selection.empty() && _note_set_n_selected == 0) {
+		trackview.editor().get_selection().remove (this);
+	}
+
+	refresh_note_set ();
 }
 
 /** Used for selection undo/redo.
@@ -2312,6 +2651,8 @@ MidiRegionView::note_selected (NoteBase* ev, bool add, bool extend)
 	} else {
 		/* find end of latest note selected, select all between that and the start of "ev" */
 
+		materialize_selection ();
+
 		Temporal::Beats earliest = std::numeric_limits<Temporal::Beats>::max();
 		Temporal::Beats latest   = Temporal::Beats();
 
@@ -2367,6 +2708,8 @@ MidiRegionView::update_drag_selection(samplepos_t start, samplepos_t end, double
 	// adjusting things that are in the area that appears/disappeared.
 	// We probably need a tree to be able to find events in O(log(n)) time.
 
+	materialize_notes (ArdourCanvas::Rect (x0, y0, x1, y1));
+
 	for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
 		if (i->second->x0() < x1 && i->second->x1() > x0 && i->second->y0() < y1 && i->second->y1() > y0) {
 			// Rectangles intersect
@@ -2433,7 +2776,7 @@ MidiRegionView::remove_from_selection (NoteBase* ev)
 	ev->set_selected (false);
 	ev->hide_velocity ();
 
-	if (_selection.empty()) {
+	if (_selection.empty() && _note_set_n_selected == 0) {
 		PublicEditor& editor (trackview.editor());
 		cerr << "Removing MRV from selection\n";
 		editor.get_selection().remove (this);
@@ -2445,7 +2788,7 @@ MidiRegionView::remove_from_selection (NoteBase* ev)
 void
 MidiRegionView::add_to_selection (NoteBase* ev)
 {
-	if (_selection.empty()) {
+	if (_selection.empty() && _note_set_n_selected == 0) {
 
 		/* first note selected in this region, force Editor region
 		 * selection to this region.
@@ -2463,6 +2806,8 @@ MidiRegionView::add_to_selection (NoteBase* ev)
 Temporal::Beats
 MidiRegionView::earliest_in_selection ()
 {
+	materialize_selection ();
+
 	Temporal::Beats earliest = std::numeric_limits<Temporal::Beats>::max();
 
 	for (Selection::iterator i = _selection.begin(); i != _selection.end(); ++i) {
@@ -2477,6 +2822,8 @@ MidiRegionView::earliest_in_selection ()
 void
 MidiRegionView::move_selection(double dx_qn, double dy, double cumulative_dy)
 {
+	materialize_selection ();
+
 	typedef vector<boost::shared_ptr<NoteType> > PossibleChord;
 	Editor* editor = dynamic_cast<Editor*> (&trackview.editor());
 	TempoMap& tmap (editor->session()->tempo_map());
@@ -2540,6 +2887,8 @@ MidiRegionView::move_selection(double dx_qn, double dy, double cumulative_dy)
 NoteBase*
 MidiRegionView::copy_selection (NoteBase* primary)
 {
+	materialize_selection ();
+
 	_copy_drag_events.clear ();
 
 	if (_selection.empty()) {
@@ -2635,6 +2984,8 @@ MidiRegionView::move_copies (double dx_qn, double dy, double cumulative_dy)
 void
 MidiRegionView::note_dropped(NoteBase *, double d_qn, int8_t dnote, bool copy)
 {
+	materialize_selection ();
+
 	uint8_t lowest_note_in_selection  = 127;
 	uint8_t highest_note_in_selection = 0;
 	uint8_t highest_note_difference   = 0;
@@ -2823,6 +3174,8 @@ MidiRegionView::region_samples_to_region_beats_double (samplepos_t samples) cons
 void
 MidiRegionView::begin_resizing (bool /*at_front*/)
 {
+	materialize_selection ();
+
 	_resize_data.clear();
 
 	for (Selection::iterator i = _selection.begin(); i != _selection.end(); ++i) {
@@ -3239,6 +3592,8 @@ MidiRegionView::change_note_length (NoteBase* event, Temporal::Beats t)
 void
 MidiRegionView::change_velocities (bool up, bool fine, bool allow_smush, bool all_together)
 {
+	materialize_selection ();
+
 	int8_t delta;
 	int8_t value = 0;
 
@@ -3300,6 +3655,8 @@ MidiRegionView::change_velocities (bool up, bool fine, bool allow_smush, bool al
 void
 MidiRegionView::transpose (bool up, bool fine, bool allow_smush)
 {
+	materialize_selection ();
+
 	if (_selection.empty()) {
 		return;
 	}
@@ -3345,6 +3702,8 @@ MidiRegionView::transpose (bool up, bool fine, bool allow_smush)
 void
 MidiRegionView::change_note_lengths (bool fine, bool shorter, Temporal::Beats delta, bool start, bool end)
 {
+	materialize_selection ();
+
 	if (!delta) {
 		if (fine) {
 			delta = Temporal::Beats(1.0/128.0);
@@ -3379,6 +3738,8 @@ MidiRegionView::change_note_lengths (bool fine, bool shorter, Temporal::Beats de
 void
 MidiRegionView::nudge_notes (bool forward, bool fine)
 {
+	materialize_selection ();
+
 	if (_selection.empty()) {
 		return;
 	}
@@ -3439,6 +3800,8 @@ MidiRegionView::nudge_notes (bool forward, bool fine)
 void
 MidiRegionView::change_channel(uint8_t channel)
 {
+	materialize_selection ();
+
 	start_note_diff_command(_("change channel"));
 	for (Selection::iterator i = _selection.begin(); i != _selection.end(); ++i) {
 		note_diff_add_change (*i, MidiModel::NoteDiffCommand::Channel, channel);
@@ -3596,6 +3959,8 @@ MidiRegionView::instrument_settings_changed ()
 void
 MidiRegionView::cut_copy_clear (Editing::CutCopyOp op)
 {
+	materialize_selection ();
+
 	if (_selection.empty()) {
 		return;
 	}
@@ -3856,6 +4221,8 @@ MidiRegionView::goto_previous_note (bool add_to_selection)
 void
 MidiRegionView::selection_as_notelist (Notes& selected, bool allow_all_if_none_selected)
 {
+	materialize_selection ();
+
 	bool had_selected = false;
 
 	/* we previously time sorted events here, but Notes is a multiset sorted by time */
@@ -203,7 +203,7 @@ public:
 	void   note_deselected(NoteBase* ev);
 	void   delete_selection();
 	void   delete_note (boost::shared_ptr<NoteType>);
-	size_t selection_size() { return _selection.size(); }
+	size_t selection_size() { return _selection.size() + _note_set_n_selected; }
 	void   select_all_notes ();
 	void   select_range(samplepos_t start, samplepos_t end);
 	void   invert_selection ();
@@ -323,7 +323,8 @@ public:
 	void show_list_editor ();
 
 	typedef std::set<NoteBase*> Selection;
-	Selection selection () const {
+	Selection selection () {
+		materialize_selection ();
 		return _selection;
 	}
 
@@ -443,6 +444,16 @@ public:
 
 	void clear_events ();
 
+	void redisplay_note_items ();
+	bool use_note_set () const;
+	void redisplay_note_set ();
+	NoteBase* materialize_note (uint32_t);
+	void materialize_notes (ArdourCanvas::Rect const &);
+	void refresh_note_set ();
+	void select_note_set_note (uint32_t, bool);
+	void materialize_selection ();
+	ArdourCanvas::Rect sustained_note_rect (boost::shared_ptr<NoteType>);
+
 	bool canvas_group_event(GdkEvent* ev);
 	bool note_canvas_event(GdkEvent* ev);
 
@@ -491,6 +502,17 @@ public:
 	SysExes                              _sys_exes;
 	Note**                               _active_notes;
 	ArdourCanvas::Container*             _note_group;
+	/** draws all notes without a canvas item of their own, once the
+	 *  region has more than UIConfiguration::max_note_items notes
+	 */
+	ArdourCanvas::NoteSet*               _note_set;
+	/** the model notes drawn by _note_set, by NoteSet::Note::index */
+	std::vector<boost::shared_ptr<NoteType> > _note_set_notes;
+	/** selection state of the notes drawn by _note_set, by NoteSet::Note::index.
+	 *  They are only given a canvas item (and added to _selection) when edited,
+	 *  see materialize_selection() */
+	std::vector<bool>                    _note_set_selected;
+	size_t                               _note_set_n_selected;
 	ARDOUR::MidiModel::NoteDiffCommand*  _note_diff_command;
 	NoteBase*                            _ghost_note;
 	double                               _last_ghost_x;
@@ -722,7 +722,7 @@ MidiStreamView::get_regions_with_selected_data (RegionSelection& rs)
 			continue;
 		}
 
-		if (!mrv->selection().empty()) {
+		if (mrv->selection_size() > 0) {
 			rs.add (*i);
 		}
 	}
@@ -53,6 +53,7 @@
 #include "ardour/monitor_control.h"
 #include "ardour/panner_shell.h"
 #include "ardour/plugin_manager.h"
+#include "ardour/plugin_pool.h"
 #include "ardour/route_group.h"
 #include "ardour/selection.h"
 #include "ardour/session.h"
@@ -3368,7 +3369,7 @@ Mixer_UI::add_favorite_processor (ARDOUR::PluginPresetPtr ppp, ProcessorPosition
 			continue;
 		}
 
-		PluginPtr p = pip->load (*_session);
+		PluginPtr p = _session->plugin_pool ().load (pip);
 
 		if (!p) {
 			continue;
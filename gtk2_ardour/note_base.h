@@ -84,6 +84,8 @@ class NoteBase : public sigc::trackable
 	virtual void move_event(double dx, double dy) = 0;
 
 	uint32_t base_color();
+	/** The color a note would be drawn with, without needing a canvas item for it */
+	static uint32_t base_color (MidiRegionView&, NoteType const &, bool selected);
 
 	void show_velocity();
 	void hide_velocity();
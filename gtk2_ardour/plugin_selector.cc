@@ -49,6 +49,8 @@
 #include "pbd/convert.h"
 #include "pbd/tokenizer.h"
 
+#include "ardour/plugin_pool.h"
+#include "ardour/session.h"
 #include "ardour/utils.h"
 
 #include "plugin_selector.h"
@@ -698,7 +700,7 @@ PluginSelector::load_plugin (PluginInfoPtr pi)
 		return PluginPtr();
 	}
 
-	return pi->load (*_session);
+	return _session->plugin_pool ().load (pi);
 }
 
 void
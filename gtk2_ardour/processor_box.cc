@@ -63,6 +63,7 @@
 #include "ardour/meter.h"
 #include "ardour/panner_shell.h"
 #include "ardour/plugin_insert.h"
+#include "ardour/plugin_pool.h"
 #include "ardour/pannable.h"
 #include "ardour/port_insert.h"
 #include "ardour/profile.h"
@@ -1948,7 +1949,7 @@ ProcessorBox::_drop_plugin_preset (Gtk::SelectionData const &data, Route::Proces
 		for (list<PluginPresetPtr>::const_iterator i = nfos.begin(); i != nfos.end(); ++i) {
 			PluginPresetPtr ppp = (*i);
 			PluginInfoPtr pip = ppp->_pip;
-			PluginPtr p = pip->load (*_session);
+			PluginPtr p = _session->plugin_pool ().load (pip);
 			if (!p) {
 				continue;
 			}
@@ -1976,7 +1977,7 @@ ProcessorBox::_drop_plugin (Gtk::SelectionData const &data, Route::ProcessorList
 		tv->get_object_drag_data (nfos, &source);
 
 		for (list<PluginInfoPtr>::const_iterator i = nfos.begin(); i != nfos.end(); ++i) {
-			PluginPtr p = (*i)->load (*_session);
+			PluginPtr p = _session->plugin_pool ().load (*i);
 			if (!p) {
 				continue;
 			}
@@ -59,6 +59,7 @@ UI_CONFIG_VARIABLE (ARDOUR::WaveformShape, waveform_shape, "waveform-shape", Tra
 UI_CONFIG_VARIABLE (bool, update_editor_during_summary_drag, "update-editor-during-summary-drag", true)
 UI_CONFIG_VARIABLE (bool, never_display_periodic_midi, "never-display-periodic-midi", true)
 UI_CONFIG_VARIABLE (bool, sound_midi_notes, "sound-midi-notes", false)
+UI_CONFIG_VARIABLE (uint32_t, max_note_items, "max-note-items", 5000) /* per MIDI region, above this notes are drawn by a single item */
 UI_CONFIG_VARIABLE (bool, show_plugin_scan_window, "show-plugin-scan-window", false)
 UI_CONFIG_VARIABLE (bool, show_zoom_tools, "show-zoom-tools", true)
 UI_CONFIG_VARIABLE (bool, use_mouse_position_as_zoom_focus_on_scroll, "use-mouse-position-as-zoom-focus-on-scroll", true)
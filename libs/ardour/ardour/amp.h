@@ -49,6 +49,7 @@ public:
 	bool configure_io (ChanCount in, ChanCount out);
 
 	void run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, double speed, pframes_t nframes, bool);
+	bool keeps_silence () const { return true; }
 
 	void set_gain_automation_buffer (gain_t *);
 
@@ -71,6 +71,18 @@ public:
 
 	bool can_truncate_peaks() const { return true; }
 	bool can_be_analysed() const    { return _length > 0; }
+	bool cacheable () const         { return !writable (); }
+
+	/* decoded-audio cache (see DecodedAudioCache) */
+
+	virtual bool decode_to_cache () const { return false; }
+	virtual std::string decoded_cache_id () const;
+	/** @return the file whose modification time and size validate decoded data */
+	virtual std::string decoded_origin () const { return _path; }
+	std::string decoded_cache_path () const;
+
+	void queue_for_decoding () const;
+	void set_decoded_cache (int fd);
 
 	static bool safe_audio_file_extension (const std::string& path);
 
@@ -81,6 +93,9 @@ public:
 
 	static PBD::Signal0<void> HeaderPositionOffsetChanged;
 
+	/** Emitted after set_gain() invalidated cached data */
+	PBD::Signal0<void> GainChanged;
+
 protected:
 	/** Constructor to be called for existing external-to-session files */
 	AudioFileSource (Session&, const std::string& path, Source::Flag flags);
@@ -107,12 +122,30 @@ protected:
 
 	static Sample* get_interleave_buffer (samplecnt_t size);
 
+	samplecnt_t read_decoded (Sample* dst, samplepos_t start, samplecnt_t cnt) const;
+	void drop_decoded_cache ();
+
 	static char bwf_country_code[3];
 	static char bwf_organization_code[4];
 	static char bwf_serial_number[13];
 
 	/** Kept up to date with the position of the session location start */
 	static samplecnt_t header_position_offset;
+
+private:
+	friend class DecodedAudioCache;
+
+	enum DecodedState {
+		DecodedUnknown,
+		DecodedQueued,
+		DecodedReady,
+		DecodedFailed
+	};
+
+	/* protects _decoded_fd; taken by readers for the duration of a read */
+	mutable Glib::Threads::Mutex _decoded_lock;
+	mutable gint                 _decoded_state;
+	int                          _decoded_fd;
 };
 
 } // namespace ARDOUR
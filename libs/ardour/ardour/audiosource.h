@@ -41,6 +41,8 @@
 
 namespace ARDOUR {
 
+class SourceBlockCache;
+
 class LIBARDOUR_API AudioSource : virtual public Source,
 		public ARDOUR::Readable
 {
@@ -61,6 +63,12 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 	virtual samplecnt_t read (Sample *dst, samplepos_t start, samplecnt_t cnt, int channel=0) const;
 	virtual samplecnt_t write (Sample *src, samplecnt_t cnt);
 
+	/** Access-pattern hints for the file backing this source (if any):
+	 * [start, start + cnt) will be read soon, or will not be re-read soon.
+	 */
+	virtual void readahead (samplepos_t /*start*/, samplecnt_t /*cnt*/) const {}
+	virtual void drop_cache (samplepos_t /*start*/, samplecnt_t /*cnt*/) const {}
+
 	virtual float sample_rate () const = 0;
 
 	virtual void mark_streaming_write_completed (const Lock& lock);
@@ -105,6 +113,11 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 
 	static void allocate_working_buffers (samplecnt_t framerate);
 
+	/** @return true if nested (compound) sources exist. Reading those uses
+	 * the shared level buffers below, so they must be read by one thread only.
+	 */
+	static bool have_nested_sources ();
+
   protected:
 	static bool _build_missing_peakfiles;
 	static bool _build_peakfiles;
@@ -135,6 +148,10 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 
 	virtual samplecnt_t read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) const = 0;
 	virtual samplecnt_t write_unlocked (Sample *dst, samplecnt_t cnt) = 0;
+
+	/** @return true if the data of this source does not change, so that
+	 * reads can be served from the session's SourceBlockCache */
+	virtual bool cacheable () const { return false; }
 	virtual std::string construct_peak_filepath (const std::string& audio_path, const bool in_session = false, const bool old_peak_name = false) const = 0;
 
 	virtual int read_peaks_with_fpp (PeakData *peaks,
@@ -146,6 +163,8 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 				     samplecnt_t samples_per_peak);
 
   private:
+	samplecnt_t read_cached (SourceBlockCache&, Sample* dst, samplepos_t start, samplecnt_t cnt) const;
+
 	bool _peaks_built;
 	/** This mutex is used to protect both the _peaks_built
 	 *  variable and also the emission (and handling) of the
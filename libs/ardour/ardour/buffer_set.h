@@ -74,6 +74,7 @@ public:
 	void clear();
 
 	void attach_buffers (PortSet& ports);
+	void attach_buffers (const ChanCount& count);
 	void get_backend_port_addresses (PortSet &, samplecnt_t);
 
 	/* the capacity here is a size_t and has a different interpretation depending
@@ -95,6 +96,13 @@ public:
 
 	void set_count(const ChanCount& count) { assert(count <= _available); _count = count; }
 
+	/** Use @a buf as buffer @a i of the given type; RT-safe, mirrors only */
+	void set_mirror_buffer (DataType type, size_t i, Buffer& buf) {
+		assert (_is_mirror);
+		assert (i < _buffers[type].size ());
+		_buffers[type][i] = &buf;
+	}
+
 	size_t buffer_capacity(DataType type) const;
 
 	AudioBuffer& get_audio(size_t i) {
@@ -27,9 +27,14 @@
 
 #include <glibmm/threads.h>
 
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
 #include "pbd/crossthread.h"
 #include "pbd/ringbuffer.h"
 #include "pbd/pool.h"
+#include "pbd/semutils.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 #include "ardour/session_handle.h"
@@ -38,6 +43,8 @@
 
 namespace ARDOUR {
 
+class Track;
+
 /**
  *  One of the Butler's functions is to clean up (ie delete) unused CrossThreadPools.
  *  When a thread with a CrossThreadPool terminates, its CTP is added to pool_trash.
@@ -61,6 +68,7 @@ class LIBARDOUR_API Butler : public SessionHandleRef
 	void drop_references ();
 
         void map_parameters ();
+	void reset_io_threads ();
 
 	samplecnt_t audio_capture_buffer_size() const { return _audio_capture_buffer_size; }
 	samplecnt_t audio_playback_buffer_size() const { return _audio_playback_buffer_size; }
@@ -75,7 +83,8 @@ class LIBARDOUR_API Butler : public SessionHandleRef
 		enum Type {
 			Run,
 			Pause,
-			Quit
+			Quit,
+			IOThreads
 		};
 	};
 
@@ -96,6 +105,34 @@ private:
 
 	bool flush_tracks_to_disk_normal (boost::shared_ptr<RouteList>, uint32_t& errors);
 
+	/* Optional helper threads ("disk-io-threads") that refill and flush
+	 * tracks concurrently with the butler, keeping several requests in
+	 * flight on devices that benefit from a deep I/O queue.
+	 */
+	enum IOJob {
+		IORefill,
+		IOFlush
+	};
+
+	uint32_t io_thread_count () const;
+	void start_io_threads (uint32_t);
+	void stop_io_threads ();
+	static void* _io_thread_work (void*);
+	void io_thread_work ();
+
+	bool run_io_jobs (IOJob, std::vector<boost::shared_ptr<Track> > const&, uint32_t& errors);
+	void process_io_jobs (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer);
+
+	std::vector<pthread_t>                  _io_threads;
+	std::vector<boost::shared_ptr<Track> >  _io_tracks;
+	IOJob                                   _io_job;
+	volatile gint                           _io_next;
+	volatile gint                           _io_unfinished;
+	volatile gint                           _io_errors;
+	volatile gint                           _io_quit;
+	PBD::Semaphore                          _io_start;
+	PBD::Semaphore                          _io_done;
+
 	/**
 	 * Add request to butler thread request queue
 	 */
@@ -0,0 +1,65 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_decoded_audio_cache_h__
+#define __ardour_decoded_audio_cache_h__
+
+#include <list>
+#include <string>
+
+#include <glibmm/threads.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR {
+
+class AudioFileSource;
+
+/** Background decoder for sources that are expensive to read or to seek in
+ * (FLAC, Ogg/Vorbis, MP3, resampled sources).
+ *
+ * Each source is decoded once into a file of raw native-endian floats in the
+ * session's "decoded" directory. The file starts with a fixed-size header
+ * recording the source file's modification time and size, the gain and the
+ * length of the decoded data; a cache file that no longer matches its source
+ * is re-created. Once a cache file is ready, the source is handed an open
+ * descriptor and serves reads from it (see AudioFileSource::read_decoded).
+ */
+class LIBARDOUR_API DecodedAudioCache {
+  public:
+	static void init ();
+	static void queue (boost::shared_ptr<AudioFileSource>);
+	static void work ();
+	static void flush ();
+
+	static const uint32_t header_size = 64;
+
+  private:
+	static Glib::Threads::Mutex active_lock;
+	static Glib::Threads::Mutex queue_lock;
+	static Glib::Threads::Cond  SourcesToDecode;
+	static std::list<boost::weak_ptr<AudioFileSource> > decode_queue;
+	static gint abort_decode;
+
+	static void decode (boost::shared_ptr<AudioFileSource>);
+	static int  open_valid (std::string const& path, boost::shared_ptr<AudioFileSource>);
+};
+
+}
+
+#endif /* __ardour_decoded_audio_cache_h__ */
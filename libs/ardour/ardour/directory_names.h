@@ -38,6 +38,7 @@ namespace ARDOUR {
 	LIBARDOUR_API extern const char* const peak_dir_name;
 	LIBARDOUR_API extern const char* const export_dir_name;
 	LIBARDOUR_API extern const char* const backup_dir_name;
+	LIBARDOUR_API extern const char* const decoded_dir_name;
 	LIBARDOUR_API extern const char* const export_formats_dir_name;
 	LIBARDOUR_API extern const char* const plugin_metadata_dir_name;
 	LIBARDOUR_API extern const char* const templates_dir_name;
@@ -48,6 +48,36 @@ class Session;
 
 template<typename T> class MidiRingBuffer;
 
+/** Disk I/O counters of one DiskReader or DiskWriter. An operation is a
+ * refill (playback) or a flush (capture) that moved some data.
+ */
+struct LIBARDOUR_API DiskIOStats {
+	static const int n_buckets = 12;
+
+	DiskIOStats () { reset (); }
+
+	void reset ();
+	void add (uint64_t bytes, uint64_t io_usec, uint64_t total_usec);
+	void note_headroom (float);
+	void merge (DiskIOStats const&);
+
+	/** @return estimated duration in usec which @param p percent of all operations did not exceed */
+	double percentile (double p) const;
+
+	/** @return number of operations that took up to bucket_limit (b) */
+	uint64_t histogram (int b) const { return (b >= 0 && b < n_buckets) ? buckets[b] : 0; }
+	/** @return upper duration limit of histogram bucket @param b in usec, 0 for the last, unbounded bucket */
+	static uint64_t bucket_limit (int b);
+
+	uint64_t ops;
+	uint64_t bytes;        ///< audio data moved, as 32-bit float samples
+	uint64_t io_usec;      ///< time spent reading from the playlist or writing to sources
+	uint64_t total_usec;   ///< time for complete operations, including buffer copies
+	uint64_t max_usec;     ///< longest single operation
+	float    min_headroom; ///< lowest buffer level seen by the butler (0..1): playback data, or capture space
+	uint64_t buckets[n_buckets];
+};
+
 class LIBARDOUR_API DiskIOProcessor : public Processor
 {
 public:
@@ -110,6 +140,9 @@ public:
 
 	virtual void adjust_buffering() = 0;
 
+	DiskIOStats io_stats () const;
+	void reset_io_stats ();
+
 protected:
 	friend class Auditioner;
 	virtual int  seek (samplepos_t which_sample, bool complete_refill = false) = 0;
@@ -127,6 +160,12 @@ protected:
 
 	Glib::Threads::Mutex state_lock;
 
+	/* written by the butler (or a disk I/O thread) */
+	void record_io (uint64_t bytes, uint64_t io_usec, uint64_t total_usec, float headroom);
+
+	mutable Glib::Threads::Mutex _io_stats_lock;
+	DiskIOStats                  _io_stats;
+
 	static bool get_buffering_presets (BufferingPreset bp,
 	                                   samplecnt_t& read_chunk_size,
 	                                   samplecnt_t& read_buffer_size,
@@ -76,6 +76,10 @@ public:
 
 	float buffer_load () const;
 
+	/** true if the last run() played back silence from disk only,
+	 * which was known to be silent without reading it. */
+	bool playback_silent () const { return _playback_silent; }
+
 	void move_processor_automation (boost::weak_ptr<Processor>, std::list<Evoral::RangeMove<samplepos_t> > const&);
 
 	/* called by the Butler in a non-realtime context as part of its normal
@@ -84,6 +88,11 @@ public:
 	 */
 	int do_refill ();
 
+	/** As do_refill(), but using the given working buffers (each at least
+	 * 2M samples), so that several tracks can be refilled concurrently.
+	 */
+	int do_refill (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer);
+
 	/** For contexts outside the normal butler refill loop (allocates temporary working buffers) */
 	int do_refill_with_alloc (bool partial_fill, bool reverse);
 
@@ -95,10 +104,46 @@ public:
 
 	void adjust_buffering ();
 
+	/** Set the size of this reader's playback buffers, or 0 to follow
+	 * the buffering preset. Takes effect with the next adjust_buffering().
+	 */
+	void set_playback_buffer_size (samplecnt_t n) { _planned_buffer_size = n; }
+	samplecnt_t playback_buffer_size () const;
+
+	/** Split a budget of @a budget samples among readers with the given
+	 * relative @a demand and number of @a channels. Each resulting buffer
+	 * size is between a quarter and twice the @a preset size; the lower
+	 * limit is reduced if the budget cannot hold it for all channels.
+	 *
+	 * @return false if the lower limit had to be reduced
+	 */
+	static bool plan_buffer_sizes (std::vector<float> const& demand, std::vector<uint32_t> const& channels,
+	                               double budget, samplecnt_t preset, std::vector<samplecnt_t>& sizes);
+
+	/** Compute the range of source data behind a forward read of @a read_cnt
+	 * samples at @a read_start which is no longer needed, keeping @a keep
+	 * samples behind the playhead. Data is never dropped while @a looping.
+	 *
+	 * @return false if nothing is to be dropped
+	 */
+	static bool drop_behind_range (samplepos_t read_start, samplecnt_t read_cnt, samplecnt_t keep, bool looping,
+	                               samplepos_t& start, samplecnt_t& cnt);
+
+	/** Average time (in usec) spent to read one sample of one channel */
+	float read_cost () const { return _read_cost; }
+
+	/** Sum of region lengths relative to the extent of the playlist,
+	 * < 1 for sparse playlists, > 1 for layered ones. */
+	float playlist_density () const;
+
 	bool can_internal_playback_seek (sampleoffset_t distance);
 	void internal_playback_seek (sampleoffset_t distance);
 	int  seek (samplepos_t sample, bool complete_refill = false);
 
+	/** Ask the OS to start reading the data needed to fill the
+	 * playback buffer at @a sample, without waiting for it. */
+	void prefetch (samplepos_t sample);
+
 	static PBD::Signal0<void> Underrun;
 
 	void playlist_modified ();
@@ -215,6 +260,11 @@ private:
 	boost::optional<bool> _last_read_reversed;
 	boost::optional<bool> _last_read_loop;
 
+	samplecnt_t _buffer_size;
+	samplecnt_t _planned_buffer_size;
+	float       _read_cost;
+	bool        _playback_silent;
+
 	static samplecnt_t _chunk_samples;
 	static gint        _no_disk_output;
 
@@ -237,6 +287,11 @@ private:
 	int refill (Sample* sum_buffer, Sample* mixdown_buffer, float* gain_buffer, samplecnt_t fill_level, bool reversed);
 	int refill_audio (Sample* sum_buffer, Sample* mixdown_buffer, float* gain_buffer, samplecnt_t fill_level, bool reversed);
 
+	void hint_audio_sources (samplepos_t start, samplecnt_t cnt, bool willneed);
+
+	samplecnt_t refill_chunk () const;
+	samplecnt_t leading_silence (samplepos_t start, samplecnt_t cnt) const;
+
 	sampleoffset_t calculate_playback_distance (pframes_t);
 
 	RTMidiBuffer* rt_midibuffer ();
@@ -143,6 +143,23 @@ namespace ARDOUR { namespace DSP {
 	 * @param n_samples number of samples in data and mmult
 	 */
 	void mmult (float *data, float *mult, const uint32_t n_samples);
+	/** apply a linearly interpolated gain
+	 *
+	 * @param data data to process in-place
+	 * @param g0 gain to apply to the first sample
+	 * @param g1 gain reached after the last sample
+	 * @param n_samples number of samples to process
+	 */
+	void apply_gain_ramp (float *data, const float g0, const float g1, const uint32_t n_samples);
+	/** add `src' with a linearly interpolated gain to `dst'
+	 *
+	 * @param dst destination buffer
+	 * @param src source buffer
+	 * @param g0 gain to apply to the first sample
+	 * @param g1 gain reached after the last sample
+	 * @param n_samples number of samples to process
+	 */
+	void mix_buffers_with_ramp (float *dst, const float *src, const float g0, const float g1, const uint32_t n_samples);
 	/** calculate peaks
 	 *
 	 * @param data data to analyze
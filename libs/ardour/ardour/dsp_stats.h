@@ -0,0 +1,61 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_dsp_stats_h__
+#define __ardour_dsp_stats_h__
+
+#include <stdint.h>
+
+#include "ardour/libardour_visibility.h"
+
+namespace ARDOUR {
+
+/** Histogram of durations in usec, e.g. the execution time of a processor,
+ * route or of the complete process cycle, or the latency of a Worker.
+ *
+ * Values are only ever added by the process thread which owns them, and
+ * other threads read a copy; no locks are involved. Processors, routes and
+ * the session only collect timings while the "dsp-profiling" option is
+ * enabled.
+ */
+struct LIBARDOUR_API DSPStats {
+	static const int n_buckets = 16;
+
+	DSPStats () { reset (); }
+
+	void reset ();
+	void add (uint64_t usec);
+	void merge (DSPStats const&);
+
+	double avg_usec () const { return cycles > 0 ? total_usec / (double) cycles : 0; }
+	/** @return estimated execution time in usec which @param p percent of all cycles did not exceed */
+	double percentile (double p) const;
+
+	/** @return number of cycles that took up to bucket_limit (b) */
+	uint64_t histogram (int b) const { return (b >= 0 && b < n_buckets) ? buckets[b] : 0; }
+	/** @return upper duration limit of histogram bucket @param b in usec, 0 for the last, unbounded bucket */
+	static uint64_t bucket_limit (int b);
+
+	uint64_t cycles;
+	uint64_t total_usec;
+	uint64_t min_usec;
+	uint64_t max_usec;
+	uint64_t buckets[n_buckets];
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_dsp_stats_h__ */
@@ -41,6 +41,7 @@
 namespace ARDOUR
 {
 class GraphNode;
+class GraphTask;
 class Graph;
 
 class Route;
@@ -76,6 +77,8 @@ public:
 
 	bool in_process_thread () const;
 
+	void run_tasks (GraphTask** tasks, uint32_t n_tasks);
+
 protected:
 	virtual void session_going_away ();
 
@@ -83,6 +86,7 @@ private:
 	void reset_thread_list ();
 	void drop_threads ();
 	void run_one ();
+	bool run_queued_task ();
 	void main_thread ();
 	void prep ();
 	void dump (int chain) const;
@@ -93,6 +97,10 @@ private:
 	PBD::MPMCQueue<GraphNode*> _trigger_queue;      ///< nodes that can be processed
 	volatile guint             _trigger_queue_size; ///< number of entries in trigger-queue
 
+	struct TaskSet;
+	PBD::MPMCQueue<TaskSet*> _task_queue;      ///< tasks of nodes being processed, one entry per helper
+	volatile guint           _task_queue_size; ///< number of entries in task-queue
+
 	/** Start worker threads */
 	PBD::Semaphore _execution_sem;
 
@@ -36,6 +36,16 @@ typedef boost::shared_ptr<GraphNode> node_ptr_t;
 typedef std::set<node_ptr_t>         node_set_t;
 typedef std::list<node_ptr_t>        node_list_t;
 
+/** A unit of work that a route may hand to idle process threads while it is
+ * being processed, see Graph::run_tasks().
+ */
+class LIBARDOUR_API GraphTask
+{
+public:
+	virtual ~GraphTask () {}
+	virtual void run () = 0;
+};
+
 class LIBARDOUR_API GraphActivision
 {
 protected:
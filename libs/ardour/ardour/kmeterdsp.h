@@ -32,6 +32,7 @@ public:
 
     void process (float const *p, int n);
     float read ();
+    float peek () const { return _rms; } // read() without resetting
     void reset ();
 
     static void init (int fsamp);
@@ -106,6 +106,7 @@ class LIBARDOUR_API LadspaPlugin : public ARDOUR::Plugin
 	bool load_preset (PresetRecord);
 
 	bool has_editor() const { return false; }
+	bool inplace_broken() const { return LADSPA_IS_INPLACE_BROKEN (_descriptor->Properties); }
 
 	/* LADSPA extras */
 
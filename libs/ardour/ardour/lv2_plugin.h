@@ -113,6 +113,7 @@ class LIBARDOUR_API LV2Plugin : public ARDOUR::Plugin, public ARDOUR::Workee
 
 	int set_block_size (pframes_t);
 	bool requires_fixed_sized_buffers () const;
+	bool inplace_broken () const { return _inplace_broken; }
 	bool connect_all_audio_outputs () const;
 
 	int connect_and_run (BufferSet& bufs,
@@ -218,6 +219,7 @@ class LIBARDOUR_API LV2Plugin : public ARDOUR::Plugin, public ARDOUR::Workee
 	uint32_t      _patch_port_out_index;
 	URIMap&       _uri_map;
 	bool          _no_sample_accurate_ctrl;
+	bool          _inplace_broken;
 	bool          _connect_all_audio_outputs;
 	bool          _can_write_automation;
 	samplecnt_t   _max_latency;
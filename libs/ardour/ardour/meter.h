@@ -73,6 +73,7 @@ public:
 
 	/** Compute peaks */
 	void run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, double speed, pframes_t nframes, bool);
+	bool keeps_silence () const { return true; }
 
 	void activate () {}
 	void deactivate () {}
@@ -82,6 +83,22 @@ public:
 
 	float meter_level (uint32_t n, MeterType type);
 
+	/** Per-channel readings, published by run() at display rate */
+	struct Levels {
+		Levels () : peak (0), max_peak (0), level (0) {}
+		float peak;     ///< peak-power in dB (MIDI: 0..1)
+		float max_peak; ///< max signal since last reset, in dB
+		float level;    ///< reading of the current meter-type, in dB
+	};
+
+	/** Copy the most recently published levels of all channels in one pass.
+	 * This is lock-free and does not interfere with the process thread.
+	 * @param type set to the meter-type that the levels were computed for
+	 * @return false if no valid snapshot is available (meter is inactive,
+	 * or a reset is pending); use meter_level() in that case.
+	 */
+	bool read_levels (std::vector<Levels>&, MeterType& type) const;
+
 	void      set_meter_type (MeterType t);
 	MeterType meter_type () const { return _meter_type; }
 
@@ -114,6 +131,23 @@ private:
 	std::vector<Vumeterdsp*> _vumeter;
 
 	MeterType _meter_type;
+
+	/* snapshot for the GUI, guarded by a sequence counter that
+	 * is odd while run() is updating it. The storage is replaced, not
+	 * resized, when more channels are needed; superseded snapshots are
+	 * kept until destruction since read_levels() may still copy from them */
+	void publish_levels ();
+	std::vector<Levels>& levels () const { return *((std::vector<Levels>*) g_atomic_pointer_get (&_levels)); }
+
+	mutable volatile gpointer          _levels; // std::vector<Levels>*
+	std::vector<std::vector<Levels>*>  _superseded_levels;
+	uint32_t                           _levels_count;
+	MeterType                          _levels_type;
+	volatile gint                      _levels_serial;
+
+	/* set when a client consumed the DSP meter readings, their
+	 * hold is restarted by the next run() */
+	mutable volatile gint _reset_dsp_hold;
 };
 
 } // namespace ARDOUR
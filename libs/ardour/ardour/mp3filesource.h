@@ -41,6 +41,8 @@ public:
 	int update_header (samplepos_t when, struct tm&, time_t) { return 0; }
 	int flush_header () { return 0; }
 	void set_header_natural_position () {};
+	bool decode_to_cache () const { return true; }
+	std::string decoded_cache_id () const;
 
 	static int get_soundfile_info (string path, SoundFileInfo& _info, string& error_msg);
 
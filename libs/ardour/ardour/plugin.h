@@ -160,6 +160,10 @@ public:
 	/** the max possible latency a plugin will have */
 	virtual samplecnt_t max_latency () const { return 0; }
 
+	/** the time a plugin may keep producing output after its input
+	 * became silent, -1 if the plugin does not tell */
+	virtual samplecnt_t signal_tail () const { return -1; }
+
 	virtual int  set_block_size (pframes_t nframes) = 0;
 	virtual bool requires_fixed_sized_buffers () const { return false; }
 	virtual bool inplace_broken () const { return false; }
@@ -36,6 +36,7 @@
 #include "ardour/libardour_visibility.h"
 #include "ardour/chan_mapping.h"
 #include "ardour/fixed_delay.h"
+#include "ardour/graphnode.h"
 #include "ardour/io.h"
 #include "ardour/types.h"
 #include "ardour/parameter_descriptor.h"
@@ -71,6 +72,9 @@ public:
 	void run (BufferSet& in, samplepos_t start_sample, samplepos_t end_sample, double speed, pframes_t nframes, bool);
 	void silence (samplecnt_t nframes, samplepos_t start_sample);
 
+	bool keeps_silence () const { return _skipping_silence; }
+	void set_silent_input () { _silent_input_hint = true; }
+
 	void activate ();
 	void deactivate ();
 	void flush ();
@@ -126,6 +130,7 @@ public:
 	bool reset_map (bool emit = true);
 	bool sanitize_maps ();
 	bool check_inplace ();
+	bool check_parallel () const;
 	bool configured () const { return _configured; }
 
 	// these are ports visible on the outside
@@ -345,6 +350,11 @@ private:
 
 	FixedDelay _delaybuffers;
 
+	/* LADSPA, LV2 and Lua plugins without MIDI I/O which are not processed
+	 * in-place are handed this mirror: audio inputs refer directly to the
+	 * route's buffers, outputs to the no-inplace buffers */
+	BufferSet _mapped_bufs;
+
 	ChanCount _configured_in;
 	ChanCount _configured_internal; // with side-chain
 	ChanCount _configured_out;
@@ -356,6 +366,8 @@ private:
 
 	bool _configured;
 	bool _no_inplace;
+	bool _alias_inputs;
+	bool _parallel_ok;
 	bool _strict_io;
 	bool _custom_cfg;
 	bool _maps_from_state;
@@ -402,12 +414,14 @@ private:
 	ChanMapping _thru_map; // out-idx <=  in-idx
 
 	void automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes);
+	bool collect_automation_events (double start, double end);
 	void connect_and_run (BufferSet& bufs, samplepos_t start, samplecnt_t end, double speed, pframes_t nframes, samplecnt_t offset, bool with_auto);
 	void bypass (BufferSet& bufs, pframes_t nframes);
 	void inplace_silence_unconnected (BufferSet&, const PinMappings&, samplecnt_t nframes, samplecnt_t offset) const;
 
 	void create_automatable_parameters ();
 	void control_list_automation_state_changed (Evoral::Parameter, AutoState);
+	void automation_list_automation_state_changed (Evoral::Parameter, AutoState);
 	void set_parameter_state_2X (const XMLNode& node, int version);
 	void set_control_ids (const XMLNode&, int version);
 	void update_control_values (const XMLNode&, int version);
@@ -425,6 +439,14 @@ private:
 
 	void latency_changed ();
 	bool _latency_changed;
+
+	/** times of the automation events of the current cycle, sorted.
+	 * The capacity is reserved up front, see collect_automation_events() */
+	std::vector<double> _automation_events;
+	/** set when the automation state of a control changed, and
+	 * _automation_events needs to be collected again */
+	gint                _automation_events_stale;
+
 	uint32_t _bypass_port;
 	bool     _inverted_bypass_enable;
 
@@ -435,6 +457,39 @@ private:
 
 	PBD::TimingStats _timing_stats;
 	volatile gint _stat_reset;
+
+	/* skipping effects with silent input, see Config->get_skip_silent_plugins() */
+	bool silent_input (BufferSet&, pframes_t) const;
+	bool silent_output (BufferSet&, pframes_t) const;
+	bool automation_playback () const;
+	samplecnt_t silence_tail () const;
+
+	bool          _silence_skippable;
+	samplecnt_t   _silent_tail;    ///< as reported by the plugin, -1 if unknown
+	samplecnt_t   _silent_samples; ///< consecutive samples of silent input and output
+	bool          _skipping_silence;
+	bool          _silent_input_hint; ///< audio input of this cycle is known to be silent
+	volatile gint _silence_wake;   ///< a parameter was changed
+
+	/** runs one replicated plugin instance on a process thread, see connect_and_run() */
+	struct ReplicaTask : public GraphTask {
+		ReplicaTask () : bufs (0), in_map (0), out_map (0), start (0), end (0), speed (0), nframes (0), offset (0), ret (0) {}
+		void run ();
+
+		boost::shared_ptr<Plugin> plugin;
+		BufferSet*                bufs;
+		ChanMapping const*        in_map;
+		ChanMapping const*        out_map;
+		samplepos_t               start;
+		samplepos_t               end;
+		double                    speed;
+		pframes_t                 nframes;
+		samplecnt_t               offset;
+		int                       ret;
+	};
+
+	std::vector<ReplicaTask> _replica_tasks;
+	std::vector<GraphTask*>  _replica_task_ptrs;
 };
 
 } // namespace ARDOUR
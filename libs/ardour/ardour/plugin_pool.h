@@ -0,0 +1,97 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_plugin_pool_h__
+#define __ardour_plugin_pool_h__
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <glibmm/threads.h>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/plugin.h"
+#include "ardour/types.h"
+
+class XMLNode;
+
+namespace ARDOUR {
+
+class Session;
+
+/** Pre-instantiated plugins of a session, created by preload() before
+ * the routes are restored, and picked up via load(). See concurrency()
+ * for the plugin formats which can be pre-loaded.
+ */
+class LIBARDOUR_API PluginPool
+{
+  public:
+	PluginPool (Session&);
+	~PluginPool ();
+
+	void preload (XMLNode const& routes);
+	void clear ();
+
+	PluginPtr take (PluginInfoPtr);
+	PluginPtr load (PluginInfoPtr);
+
+	enum Concurrency {
+		GUIThreadOnly,
+		Serialized,
+		Concurrent
+	};
+
+	/* LV2 is serialized, lilv's world is not thread-safe */
+	static Concurrency concurrency (PluginType);
+
+  private:
+	typedef std::pair<PluginType, std::string> Key;
+
+	struct Job {
+		Job (PluginInfoPtr i) : info (i), usec (0) {}
+		PluginInfoPtr info;
+		PluginPtr     plugin;
+		int64_t       usec;
+	};
+
+	Session& _session;
+
+	Glib::Threads::Mutex _lock;
+	std::map<Key, std::list<PluginPtr> > _idle;
+	std::map<Key, PluginInfoPtr>         _spares;
+
+	/* preload */
+	std::vector<Job> _jobs;
+	gint             _next_job;
+	Glib::Threads::Mutex _serial_lock;
+
+	/* background refill */
+	Glib::Threads::Thread* _thread;
+	Glib::Threads::Cond    _refill_cond;
+	std::list<Key>         _refill_queue;
+	bool                   _quit;
+
+	PluginPtr instantiate (PluginInfoPtr, int64_t& usec);
+	void preload_worker ();
+	void refill_thread ();
+	void queue_refill (Key const&);
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_plugin_pool_h__ */
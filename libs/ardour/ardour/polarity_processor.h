@@ -31,6 +31,7 @@ public:
 
 	bool display_to_user() const { return false; }
 	void run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, double speed, pframes_t nframes, bool result_required);
+	bool keeps_silence () const { return true; }
 	bool configure_io (ChanCount in, ChanCount out);
 	bool can_support_io_configuration (const ChanCount& in, ChanCount& out);
 
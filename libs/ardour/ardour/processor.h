@@ -30,6 +30,7 @@
 
 #include "ardour/ardour.h"
 #include "ardour/buffer_set.h"
+#include "ardour/dsp_stats.h"
 #include "ardour/latent.h"
 #include "ardour/session_object.h"
 #include "ardour/libardour_visibility.h"
@@ -100,6 +101,11 @@ class LIBARDOUR_API Processor : public SessionObject, public Automatable, public
 	virtual void run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, double speed, pframes_t nframes, bool result_required) {}
 	virtual void silence (samplecnt_t nframes, samplepos_t start_sample) { automation_run (start_sample, nframes); }
 
+	/** @return true if run() leaves silent audio buffers silent */
+	virtual bool keeps_silence () const { return false; }
+	/** Called before run() when all audio input of the cycle is known to be silent */
+	virtual void set_silent_input () {}
+
 	virtual void activate ()   { _pending_active = true; ActiveChanged(); }
 	virtual void deactivate () { _pending_active = false; ActiveChanged(); }
 	virtual void flush() {}
@@ -156,6 +162,12 @@ class LIBARDOUR_API Processor : public SessionObject, public Automatable, public
 	virtual void set_owner (SessionObject*);
 	SessionObject* owner() const;
 
+	/** @return execution time of run(), collected while Config->get_dsp_profiling() is set */
+	DSPStats dsp_stats () const { return _dsp_stats; }
+	void reset_dsp_stats ();
+	/* only to be called by the thread running this processor */
+	void add_dsp_time (uint64_t usec);
+
 protected:
 	virtual XMLNode& state ();
 	virtual int set_state_2X (const XMLNode&, int version);
@@ -181,6 +193,10 @@ protected:
 	samplecnt_t _capture_offset;
 	samplecnt_t _playback_offset;
 	Location*   _loop_location;
+
+private:
+	DSPStats _dsp_stats;
+	gint     _dsp_stats_reset;
 };
 
 } // namespace ARDOUR
@@ -94,6 +94,11 @@ CONFIG_VARIABLE (BufferingPreset, buffering_preset, "buffering-preset", Medium)
 CONFIG_VARIABLE (float, audio_capture_buffer_seconds, "capture-buffer-seconds", 5.0)
 CONFIG_VARIABLE (float, audio_playback_buffer_seconds, "playback-buffer-seconds", 5.0)
 CONFIG_VARIABLE (float, midi_track_buffer_seconds, "midi-track-buffer-seconds", 1.0)
+CONFIG_VARIABLE (uint32_t, disk_io_threads, "disk-io-threads", 0)
+CONFIG_VARIABLE (bool, disk_drop_behind, "disk-drop-behind", false)
+CONFIG_VARIABLE (uint32_t, playback_buffer_budget, "playback-buffer-budget", 0) /* MB, 0: fixed size per track */
+CONFIG_VARIABLE (uint32_t, source_block_cache_size, "source-block-cache-size", 0) /* MB, 0: disabled */
+CONFIG_VARIABLE (bool, decoded_audio_cache, "decoded-audio-cache", false)
 CONFIG_VARIABLE (uint32_t, disk_choice_space_threshold,  "disk-choice-space-threshold", 57600000)
 CONFIG_VARIABLE (bool, auto_analyse_audio, "auto-analyse-audio", false)
 CONFIG_VARIABLE (float, transient_sensitivity, "transient-sensitivity", 50)
@@ -208,6 +213,7 @@ CONFIG_VARIABLE_SPECIAL (std::string, default_session_parent_dir, "default-sessi
 #endif
 CONFIG_VARIABLE (bool, allow_special_bus_removal, "allow-special-bus-removal", false)
 CONFIG_VARIABLE (int32_t, processor_usage, "processor-usage", -1)
+CONFIG_VARIABLE (bool, dsp_profiling, "dsp-profiling", false) /* time each processor, route and process cycle, see Session::dsp_stats() */
 CONFIG_VARIABLE (gain_t, max_gain, "max-gain", 2.0) /* +6.0dB */
 CONFIG_VARIABLE (uint32_t, max_recent_sessions, "max-recent-sessions", 10)
 CONFIG_VARIABLE (uint32_t, max_recent_templates, "max-recent-templates", 10)
@@ -219,6 +225,13 @@ CONFIG_VARIABLE (EditMode, edit_mode, "edit-mode", Slide)
 /* plugin related */
 
 CONFIG_VARIABLE (bool, new_plugins_active, "new-plugins-active", true)
+CONFIG_VARIABLE (bool, parallel_replicated_plugins, "parallel-replicated-plugins", false)
+CONFIG_VARIABLE (uint32_t, automation_split_min, "automation-split-min", 1) /* samples, shortest block a plugin is run for between automation events; values > 1 delay events */
+CONFIG_VARIABLE (uint32_t, lua_dsp_gc_budget, "lua-dsp-gc-budget", 16) /* KBytes of garbage collection work per cycle and Lua DSP plugin, 0: a small basic step */
+CONFIG_VARIABLE (bool, preload_plugins, "preload-plugins", false) /* instantiate a session's plugins concurrently before restoring routes */
+CONFIG_VARIABLE (uint32_t, spare_plugin_instances, "spare-plugin-instances", 0) /* idle instances of plugins used more than once in a session */
+CONFIG_VARIABLE (bool, skip_silent_plugins, "skip-silent-plugins", false) /* don't run effects while their input and output are silent */
+CONFIG_VARIABLE (uint32_t, silent_plugin_hold, "silent-plugin-hold", 2000) /* msec of silent output before skipping plugins which don't report a tail */
 CONFIG_VARIABLE (bool, use_plugin_own_gui, "use-plugin-own-gui", true)
 CONFIG_VARIABLE (bool, use_windows_vst, "use-windows-vst", true)
 CONFIG_VARIABLE (bool, use_lxvst, "use-lxvst", true)
@@ -226,7 +239,10 @@ CONFIG_VARIABLE (bool, use_macvst, "use-macvst", true)
 CONFIG_VARIABLE (bool, discover_vst_on_start, "discover-vst-on-start", false)
 CONFIG_VARIABLE (bool, verbose_plugin_scan, "verbose-plugin-scan", false)
 CONFIG_VARIABLE (bool, conceal_lv1_if_lv2_exists, "conceal-lv1-if-lv2-exists", true)
+CONFIG_VARIABLE (bool, lv2_plugin_catalogue, "lv2-plugin-catalogue", false) /* list LV2 plugins from a cache, load bundles on demand */
+CONFIG_VARIABLE (uint32_t, lv2_worker_threads, "lv2-worker-threads", 0) /* threads shared by all LV2 plugin workers, 0: one per CPU core */
 CONFIG_VARIABLE (int, vst_scan_timeout, "vst-scan-timeout", 1200) /* deciseconds, per plugin, <= 0 no timeout */
+CONFIG_VARIABLE (uint32_t, vst_scan_jobs, "vst-scan-jobs", 0) /* concurrent scanner processes, 0: one per CPU, 1: serial */
 CONFIG_VARIABLE (bool, discover_audio_units, "discover-audio-units", false)
 CONFIG_VARIABLE (bool, ask_replace_instrument, "ask-replace-instrument", true)
 CONFIG_VARIABLE (bool, ask_setup_instrument, "ask-setup-instrument", true)
@@ -240,6 +240,9 @@ public:
 
 	std::list<std::string> unknown_processors () const;
 
+	DSPStats dsp_stats () const;
+	void reset_dsp_stats ();
+
 	RoutePinWindowProxy * pinmgr_proxy () const { return _pinmgr_proxy; }
 	void set_pingmgr_proxy (RoutePinWindowProxy* wp) { _pinmgr_proxy = wp ; }
 
@@ -647,6 +650,9 @@ protected:
 	gint           _pending_listen_change; // atomic
 	gint           _pending_signals; // atomic
 
+	DSPStats       _dsp_stats;
+	gint           _dsp_stats_reset; // atomic
+
 	MeterPoint     _meter_point;
 	MeterPoint     _pending_meter_point;
 
@@ -132,6 +132,7 @@ class Bundle;
 class Butler;
 class Click;
 class CoreSelection;
+struct DiskIOStats;
 class ExportHandler;
 class ExportStatus;
 class Graph;
@@ -148,6 +149,7 @@ class MidiTrack;
 class Playlist;
 class PluginInsert;
 class PluginInfo;
+class PluginPool;
 class Port;
 class PortInsert;
 class ProcessThread;
@@ -165,6 +167,7 @@ class SessionDirectory;
 class SessionMetadata;
 class SessionPlaylists;
 class Source;
+class SourceBlockCache;
 class Speakers;
 class TempoMap;
 class TransportMaster;
@@ -301,6 +304,7 @@ public:
 
 	void refill_all_track_buffers ();
 	Butler* butler() { return _butler; }
+	PluginPool& plugin_pool() { return *_plugin_pool; }
 	void butler_transport_work ();
 
 	void refresh_disk_space ();
@@ -316,6 +320,9 @@ public:
 
 	CoreSelection& selection () { return *_selection; }
 
+	/** Cache of decoded audio, shared by all sources; may be 0 */
+	SourceBlockCache* block_cache () const { return _block_cache; }
+
 	/* because the set of Stripables consists of objects managed
 	 * independently, in multiple containers within the Session (or objects
 	 * owned by the session), we fill out a list in-place rather than
@@ -337,6 +344,8 @@ public:
 	uint32_t nbusses () const;
 
 	bool plot_process_graph (std::string const& file_name) const;
+	/** @return the process graph, or 0 when routes are processed by a single thread */
+	Graph* process_graph () const { return _process_graph.get (); }
 
 	boost::shared_ptr<BundleList> bundles () {
 		return _bundles.reader ();
@@ -798,6 +807,17 @@ public:
 	unsigned int    get_xrun_count () const {return _xrun_count; }
 	void            reset_xrun_count () {_xrun_count = 0; }
 
+	/* disk I/O statistics, summed over all tracks */
+	DiskIOStats     playback_io_stats () const;
+	DiskIOStats     capture_io_stats () const;
+	void            reset_io_stats ();
+
+	/* execution time of the complete process cycle, see also
+	 * Route::dsp_stats() and Processor::dsp_stats()
+	 */
+	DSPStats        dsp_stats () const { return _dsp_stats; }
+	void            reset_dsp_stats ();
+
 	/* region info  */
 
 	boost::shared_ptr<Region> find_whole_file_parent (boost::shared_ptr<Region const>) const;
@@ -1310,6 +1330,8 @@ private:
 	bool                    _session_range_is_free;
 	bool                    _silent;
 	samplecnt_t             _remaining_latency_preroll;
+	DSPStats                _dsp_stats;
+	gint                    _dsp_stats_reset;
 
 	// varispeed playback -- TODO: move out of session to backend.
 	double                  _engine_speed;
@@ -1501,6 +1523,7 @@ private:
 	void try_run_lua (pframes_t);
 
 	Butler* _butler;
+	PluginPool* _plugin_pool;
 
 	TransportFSM* _transport_fsm;
 
@@ -1513,6 +1536,8 @@ private:
 
 	void schedule_playback_buffering_adjustment ();
 	void schedule_capture_buffering_adjustment ();
+	bool plan_playback_buffering (boost::shared_ptr<RouteList>);
+	bool _playback_budget_short; ///< budget cannot hold minimum sized buffers
 
 	Locations*       _locations;
 	void location_added (Location*);
@@ -1541,6 +1566,7 @@ private:
 	int  post_engine_init ();
 	int  immediately_post_engine ();
 	void remove_empty_sounds ();
+	void cleanup_decoded_audio ();
 
 	void session_loaded ();
 
@@ -2175,6 +2201,8 @@ private:
 
 	bool _had_destructive_tracks;
 
+	SourceBlockCache* _block_cache;
+
 	std::string unnamed_file_name () const;
 };
 
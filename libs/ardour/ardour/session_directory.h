@@ -110,6 +110,13 @@ public:
 	 */
 	const std::string backup_path () const;
 
+	/**
+	 * @return The absolute path to the directory in which decoded
+	 * copies of compressed sources are cached. It is not one of
+	 * the required subdirectories and is created on demand.
+	 */
+	const std::string decoded_path () const;
+
 	/**
 	 * @return true if session directory and all the required
 	 * subdirectories exist.
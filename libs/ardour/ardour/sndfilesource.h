@@ -69,6 +69,13 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	uint32_t channel_count () const { return _info.channels; }
 
 	bool clamped_at_unity () const;
+	bool cacheable () const;
+	bool decode_to_cache () const;
+
+	void mark_streaming_write_completed (const Lock& lock);
+
+	void readahead (samplepos_t start, samplecnt_t cnt) const;
+	void drop_cache (samplepos_t start, samplecnt_t cnt) const;
 
 	static const Source::Flag default_writable_flags;
 
@@ -89,6 +96,28 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	SF_INFO _info;
 	BroadcastInfo *_broadcast_info;
 
+	/* descriptor owned by libsndfile, used for allocation and caching hints */
+	int   _fd;
+	off_t _preallocated;
+	off_t _write_behind;
+	off_t _drop_pending;
+	off_t _drop_behind;
+
+	void write_behind ();
+	void release_preallocation ();
+	bool file_range (samplepos_t start, samplecnt_t cnt, off_t& offset, off_t& len) const;
+
+	/* read-only mapping of native-endian float data, bypassing libsndfile */
+	char*       _map_addr;
+	size_t      _map_length;
+	float*      _map_data;
+	samplecnt_t _map_frames;
+
+	bool can_map () const;
+	void map_file ();
+	void unmap_file ();
+	samplecnt_t read_mapped (Sample* dst, samplepos_t start, samplecnt_t cnt) const;
+
 	void init_sndfile ();
 	int open();
 	int setup_broadcast_info (samplepos_t when, struct tm&, time_t);
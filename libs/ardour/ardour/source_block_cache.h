@@ -0,0 +1,104 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_source_block_cache_h__
+#define __ardour_source_block_cache_h__
+
+#include <list>
+#include <map>
+
+#include <glib.h>
+#include <glibmm/threads.h>
+
+#include "pbd/id.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** A cache of decoded audio data, shared by all readers of a source.
+ *
+ * Sources are read in fixed-size blocks, which are kept in memory up to
+ * a given budget and evicted least-recently-used first. The cache is split
+ * into shards, each with its own lock, so that readers of different
+ * sources rarely contend.
+ */
+class LIBARDOUR_API SourceBlockCache
+{
+public:
+	SourceBlockCache (size_t max_bytes);
+	~SourceBlockCache ();
+
+	/** size of a cache block in samples */
+	static const samplecnt_t block_size = 32768;
+
+	bool enabled () const { return _max_blocks > 0; }
+	void set_max_bytes (size_t);
+
+	/** Copy @a cnt samples at @a offset of the given block to @a dst.
+	 * @return false if the block is not cached
+	 */
+	bool get (PBD::ID const& source, int64_t block, Sample* dst, samplecnt_t offset, samplecnt_t cnt);
+
+	/** Add a block of @a cnt samples (at most block_size) */
+	void put (PBD::ID const& source, int64_t block, Sample const* src, samplecnt_t cnt);
+
+	/** Forget all blocks of the given source */
+	void drop (PBD::ID const& source);
+	void clear ();
+
+	guint hits () const { return (guint) g_atomic_int_get (&_hits); }
+	guint misses () const { return (guint) g_atomic_int_get (&_misses); }
+
+private:
+	typedef std::pair<PBD::ID, int64_t> Key;
+
+	struct Block {
+		Block (Key const& k) : key (k), data (new Sample[block_size]), length (0) {}
+		~Block () { delete [] data; }
+
+		Key         key;
+		Sample*     data;
+		samplecnt_t length;
+	};
+
+	typedef std::list<Block*> BlockList;
+
+	struct Shard {
+		Shard () : n_blocks (0) {}
+
+		Glib::Threads::Mutex         lock;
+		BlockList                    lru; /* most recently used first */
+		std::map<Key, BlockList::iterator> index;
+		size_t                       n_blocks;
+	};
+
+	static const size_t n_shards = 16;
+
+	Shard&  shard (Key const&);
+	void    evict (Shard&, size_t max_blocks);
+	size_t  shard_max_blocks () const;
+
+	Shard   _shards[n_shards];
+	size_t  _max_blocks;
+	gint    _hits;
+	gint    _misses;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_source_block_cache_h__ */
@@ -49,6 +49,10 @@ public:
 	bool can_be_analysed() const { return false; }
 	bool clamped_at_unity() const { return false; }
 
+	bool decode_to_cache () const { return true; }
+	std::string decoded_cache_id () const;
+	std::string decoded_origin () const { return _source->decoded_origin (); }
+
 protected:
 	void close ();
 	samplecnt_t read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) const;
@@ -63,6 +67,9 @@ protected:
 private:
 	static const uint32_t max_blocksize;
 	boost::shared_ptr<AudioFileSource> _source;
+	PBD::ScopedConnection _source_gain_connection;
+
+	void source_gain_changed ();
 
 	mutable SRC_STATE* _src_state;
 	mutable SRC_DATA   _src_data;
@@ -73,6 +80,7 @@ private:
 	mutable double _fract_position;
 
 	double _ratio;
+	int    _src_type;
 	samplecnt_t src_buffer_size;
 };
 
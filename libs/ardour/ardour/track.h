@@ -39,6 +39,7 @@ class Source;
 class Region;
 class DiskReader;
 class DiskWriter;
+struct DiskIOStats;
 class IO;
 class RecordEnableControl;
 class RecordSafeControl;
@@ -137,9 +138,11 @@ public:
 	float playback_buffer_load () const;
 	float capture_buffer_load () const;
 	int do_refill ();
+	int do_refill (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer);
 	int do_flush (RunContext, bool force = false);
 	void set_pending_overwrite (OverwriteReason);
 	int seek (samplepos_t, bool complete_refill = false);
+	void prefetch (samplepos_t);
 	bool can_internal_playback_seek (samplecnt_t);
 	void internal_playback_seek (samplecnt_t);
 	void non_realtime_locate (samplepos_t);
@@ -167,6 +170,13 @@ public:
 	}
 	void adjust_playback_buffering ();
 	void adjust_capture_buffering ();
+	samplecnt_t playback_buffer_size () const;
+	void set_playback_buffer_size (samplecnt_t);
+	float playback_read_cost () const;
+	float playback_density () const;
+	DiskIOStats playback_io_stats () const;
+	DiskIOStats capture_io_stats () const;
+	void reset_io_stats ();
 	void reload_loop ();
 
 	PBD::Signal0<void> FreezeChange;
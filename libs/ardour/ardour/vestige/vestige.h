@@ -113,6 +113,7 @@
 #define effGetProductString 48
 #define effGetVendorVersion 49
 #define effCanDo 51 // currently unused
+#define effGetTailSize 52
 /* from http://asseca.com/vst-24-specs/efIdle.html */
 #define effIdle 53
 /* from http://asseca.com/vst-24-specs/efGetParameterProperties.html */
@@ -21,6 +21,7 @@
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/vst_types.h"
+#include <string>
 #include <vector>
 
 /* Cache File extensions */
@@ -33,9 +34,11 @@
 # if ( defined(__x86_64__) || defined(_M_X64) )
 #define VST_EXT_INFOFILE  ".fsi64"
 #define VST_BLACKLIST  "vst64_blacklist.txt"
+#define VST_INDEX  "vst64_index.txt"
 #else
 #define VST_EXT_INFOFILE  ".fsi32"
 #define VST_BLACKLIST  "vst32_blacklist.txt"
+#define VST_INDEX  "vst32_index.txt"
 #endif
 
 #ifndef VST_SCANNER_APP
@@ -62,6 +65,11 @@ LIBARDOUR_API extern std::vector<VSTInfo*> * vstfx_get_info_fst (char *, enum VS
 LIBARDOUR_API extern std::vector<VSTInfo*> * vstfx_get_info_mac (char *, enum VSTScanMode mode = VST_SCAN_USE_APP);
 #endif
 
+#ifndef VST_SCANNER_APP
+LIBARDOUR_API extern void vstfx_scan_parallel (std::vector<std::string> const& dllpaths);
+LIBARDOUR_API extern void vstfx_save_index ();
+#endif
+
 #ifndef VST_SCANNER_APP
 } // namespace
 #endif
@@ -32,6 +32,7 @@ public:
 
     void process (float const *p, int n);
     float read (void);
+    float peek () const { return _g * _m; } // read() without resetting
     void reset ();
 
     static void init (float fsamp);
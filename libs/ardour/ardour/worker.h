@@ -28,11 +28,13 @@
 #include "pbd/ringbuffer.h"
 #include "pbd/semutils.h"
 
+#include "ardour/dsp_stats.h"
 #include "ardour/libardour_visibility.h"
 
 namespace ARDOUR {
 
 class Worker;
+class WorkerPool;
 
 /**
    An object that needs to schedule non-RT work in the audio thread.
@@ -55,9 +57,10 @@ public:
 /**
    A worker for non-realtime tasks scheduled from another thread.
 
-   A worker may be a separate thread that runs to execute scheduled work
-   asynchronously, or unthreaded, in which case work is executed immediately
-   upon scheduling by the calling thread.
+   A worker may be threaded, in which case scheduled work is executed
+   asynchronously by a pool of threads shared by all workers, or unthreaded,
+   in which case work is executed immediately upon scheduling by the calling
+   thread.
 */
 class LIBARDOUR_API Worker
 {
@@ -92,8 +95,24 @@ public:
 	*/
 	void set_synchronous(bool synchronous) { _synchronous = synchronous; }
 
+	/**
+	   Time from schedule() until the response was emitted, in usec.
+	*/
+	DSPStats latency_stats() const { return _latency; }
+
+	/**
+	   Latency statistics of all threaded workers.
+	*/
+	static DSPStats pool_stats();
+
 private:
-	void run();
+	friend class WorkerPool;
+
+	/** pool thread: @return true if a complete request is queued */
+	bool has_request();
+	/** pool thread: execute one queued request */
+	void process_request();
+
 	/**
 	   Peek in RB, get size and check if a block of 'size' is available.
 
@@ -109,9 +128,11 @@ private:
 	PBD::RingBuffer<uint8_t>* _requests;
 	PBD::RingBuffer<uint8_t>* _responses;
 	uint8_t*                  _response;
-	PBD::Semaphore            _sem;
-	Glib::Threads::Thread*    _thread;
-	bool                      _exit;
+	uint8_t*                  _request;
+	size_t                    _request_size;
+	int64_t                   _request_time; ///< schedule time of the request being executed
+	DSPStats                  _latency;
+	gint                      _busy;         ///< atomic, a pool thread executes a request
 	bool                      _synchronous;
 };
 
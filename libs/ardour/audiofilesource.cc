@@ -46,15 +46,20 @@
 
 #include <sndfile.h>
 
+#include <glibmm/checksum.h>
 #include <glibmm/miscutils.h>
 #include <glibmm/fileutils.h>
 #include <glibmm/threads.h>
 
 #include "ardour/audiofilesource.h"
 #include "ardour/debug.h"
+#include "ardour/decoded_audio_cache.h"
 #include "ardour/mp3filesource.h"
 #include "ardour/sndfilesource.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/session.h"
+#include "ardour/session_directory.h"
+#include "ardour/source_block_cache.h"
 #include "ardour/filename_extensions.h"
 
 // if these headers come before sigc++ is included
@@ -99,6 +104,8 @@ AudioFileSource::AudioFileSource (Session& s, const string& path, Source::Flag f
 	, AudioSource (s, path)
           /* note that external files have their own path as "origin" */
 	, FileSource (s, DataType::AUDIO, path, path, flags)
+	, _decoded_state (DecodedUnknown)
+	, _decoded_fd (-1)
 {
 	if (init (_path, true)) {
 		throw failed_constructor ();
@@ -111,6 +118,8 @@ AudioFileSource::AudioFileSource (Session& s, const string& path, const string&
 	: Source (s, DataType::AUDIO, path, flags)
 	, AudioSource (s, path)
 	, FileSource (s, DataType::AUDIO, path, origin, flags)
+	, _decoded_state (DecodedUnknown)
+	, _decoded_fd (-1)
 {
         /* note that origin remains empty */
 
@@ -126,6 +135,8 @@ AudioFileSource::AudioFileSource (Session& s, const string& path, Source::Flag f
 	: Source (s, DataType::AUDIO, path, flags)
 	, AudioSource (s, path)
 	, FileSource (s, DataType::AUDIO, path, string(), flags)
+	, _decoded_state (DecodedUnknown)
+	, _decoded_fd (-1)
 {
         /* note that origin remains empty */
 
@@ -145,6 +156,8 @@ AudioFileSource::AudioFileSource (Session& s, const XMLNode& node, bool must_exi
 	: Source (s, node)
 	, AudioSource (s, node)
 	, FileSource (s, node, must_exist)
+	, _decoded_state (DecodedUnknown)
+	, _decoded_fd (-1)
 {
 	if (set_state (node, Stateful::loading_state_version)) {
 		throw failed_constructor ();
@@ -162,9 +175,13 @@ AudioFileSource::AudioFileSource (Session& s, const XMLNode& node, bool must_exi
 AudioFileSource::~AudioFileSource ()
 {
 	DEBUG_TRACE (DEBUG::Destruction, string_compose ("AudioFileSource destructor %1, removable? %2\n", _path, removable()));
+	drop_decoded_cache ();
 	if (removable()) {
 		::g_unlink (_path.c_str());
 		::g_unlink (_peakpath.c_str());
+		if (decode_to_cache ()) {
+			::g_unlink (decoded_cache_path ().c_str());
+		}
 	}
 }
 
@@ -297,6 +314,13 @@ AudioFileSource::set_gain (float g, bool temporarily)
 		return;
 	}
 	_gain = g;
+
+	/* cached data was read with the previous gain */
+	if (SourceBlockCache* cache = _session.block_cache ()) {
+		cache->drop (id ());
+	}
+	drop_decoded_cache ();
+	GainChanged (); /* EMIT SIGNAL */
 	if (temporarily) {
 		return;
 	}
@@ -304,6 +328,125 @@ AudioFileSource::set_gain (float g, bool temporarily)
 	setup_peakfile ();
 }
 
+string
+AudioFileSource::decoded_cache_id () const
+{
+	string id = _path;
+	id += '%';
+	id += (char) ('A' + _channel);
+	return id;
+}
+
+string
+AudioFileSource::decoded_cache_path () const
+{
+	string const name = Glib::Checksum::compute_checksum (Glib::Checksum::CHECKSUM_SHA1, decoded_cache_id ());
+	return Glib::build_filename (_session.session_directory().decoded_path(), name + ".f32");
+}
+
+/** Ask DecodedAudioCache to decode this source, unless that has already
+ * been done or tried.
+ */
+void
+AudioFileSource::queue_for_decoding () const
+{
+#ifndef PLATFORM_WINDOWS
+	if (!decode_to_cache () || !Config->get_decoded_audio_cache ()) {
+		return;
+	}
+	if (!g_atomic_int_compare_and_exchange (&_decoded_state, DecodedUnknown, DecodedQueued)) {
+		return;
+	}
+	try {
+		boost::shared_ptr<Source> s = boost::const_pointer_cast<Source> (shared_from_this ());
+		DecodedAudioCache::queue (boost::dynamic_pointer_cast<AudioFileSource> (s));
+	} catch (boost::bad_weak_ptr&) {
+		/* not (yet) owned by a shared_ptr */
+		g_atomic_int_set (&_decoded_state, DecodedUnknown);
+	}
+#endif
+}
+
+/** Called by DecodedAudioCache with a descriptor of a valid decoded file,
+ * or -1 if decoding failed.
+ */
+void
+AudioFileSource::set_decoded_cache (int fd)
+{
+	Glib::Threads::Mutex::Lock lm (_decoded_lock);
+
+	if (g_atomic_int_get (&_decoded_state) != DecodedQueued) {
+		/* invalidated (e.g. by a gain change) while decoding */
+		if (fd >= 0) {
+			::close (fd);
+		}
+		return;
+	}
+	if (fd < 0) {
+		g_atomic_int_set (&_decoded_state, DecodedFailed);
+		return;
+	}
+	_decoded_fd = fd;
+	g_atomic_int_set (&_decoded_state, DecodedReady);
+}
+
+/* waits for a concurrent read_decoded() before closing the descriptor */
+void
+AudioFileSource::drop_decoded_cache ()
+{
+	Glib::Threads::Mutex::Lock lm (_decoded_lock);
+
+	g_atomic_int_set (&_decoded_state, DecodedUnknown);
+	if (_decoded_fd >= 0) {
+		::close (_decoded_fd);
+		_decoded_fd = -1;
+	}
+}
+
+/** Read decoded data, if this source has been decoded. Queues the source
+ * for decoding on first use.
+ *
+ * @return number of samples read, or -1 if the caller has to decode itself.
+ */
+samplecnt_t
+AudioFileSource::read_decoded (Sample* dst, samplepos_t start, samplecnt_t cnt) const
+{
+#ifdef PLATFORM_WINDOWS
+	return -1;
+#else
+	if (g_atomic_int_get (&_decoded_state) == DecodedUnknown) {
+		queue_for_decoding ();
+		return -1;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_decoded_lock);
+
+	if (g_atomic_int_get (&_decoded_state) != DecodedReady) {
+		return -1;
+	}
+
+	const samplecnt_t len   = readable_length ();
+	const samplecnt_t avail = max ((samplecnt_t) 0, min (cnt, len - start));
+
+	if (avail > 0) {
+		const off_t   offset = DecodedAudioCache::header_size + (off_t) start * sizeof (Sample);
+		const ssize_t bytes  = avail * sizeof (Sample);
+
+		if (::pread (_decoded_fd, dst, bytes, offset) != bytes) {
+			/* fall back to decoding; do not try again */
+			g_atomic_int_set (&_decoded_state, DecodedFailed);
+			return -1;
+		}
+	}
+
+	if (avail < cnt) {
+		memset (dst + avail, 0, sizeof (Sample) * (cnt - avail));
+	}
+
+	return avail;
+#endif
+}
+
 bool
 AudioFileSource::safe_audio_file_extension(const string& file)
 {
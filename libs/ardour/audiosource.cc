@@ -63,6 +63,7 @@
 #include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/session.h"
+#include "ardour/source_block_cache.h"
 
 #include "pbd/i18n.h"
 
@@ -132,6 +133,10 @@ AudioSource::~AudioSource ()
 		_peakfile_fd = -1;
 	}
 
+	if (SourceBlockCache* cache = _session.block_cache ()) {
+		cache->drop (id ());
+	}
+
 	delete [] peak_leftovers;
 }
 
@@ -322,9 +327,61 @@ AudioSource::read (Sample *dst, samplepos_t start, samplecnt_t cnt, int /*channe
 	assert (cnt >= 0);
 
 	Glib::Threads::Mutex::Lock lm (_lock);
+
+	SourceBlockCache* cache = _session.block_cache ();
+
+	if (cache && cache->enabled () && cacheable ()) {
+		return read_cached (*cache, dst, start, cnt);
+	}
+
 	return read_unlocked (dst, start, cnt);
 }
 
+/** Read via the session's block cache, reading and adding whole blocks
+ * on a miss. Called with _lock held.
+ */
+samplecnt_t
+AudioSource::read_cached (SourceBlockCache& cache, Sample* dst, samplepos_t start, samplecnt_t cnt) const
+{
+	const samplecnt_t bs    = SourceBlockCache::block_size;
+	const samplecnt_t avail = max ((samplecnt_t) 0, min (cnt, _length - start));
+
+	boost::scoped_array<Sample> block_buf;
+	samplecnt_t                 done = 0;
+
+	while (done < avail) {
+		const samplepos_t pos    = start + done;
+		const int64_t     block  = pos / bs;
+		const samplecnt_t offset = pos - block * bs;
+		const samplecnt_t n      = min (avail - done, bs - offset);
+
+		if (!cache.get (id (), block, dst + done, offset, n)) {
+
+			const samplecnt_t block_len = min (bs, _length - block * bs);
+
+			if (!block_buf) {
+				block_buf.reset (new Sample[bs]);
+			}
+
+			if (read_unlocked (block_buf.get (), block * bs, block_len) != block_len) {
+				/* leave error handling to the direct read */
+				return done + read_unlocked (dst + done, pos, cnt - done);
+			}
+
+			cache.put (id (), block, block_buf.get (), block_len);
+			memcpy (dst + done, block_buf.get () + offset, sizeof (Sample) * n);
+		}
+
+		done += n;
+	}
+
+	if (avail < cnt) {
+		memset (dst + avail, 0, sizeof (Sample) * (cnt - avail));
+	}
+
+	return avail;
+}
+
 samplecnt_t
 AudioSource::write (Sample *dst, samplecnt_t cnt)
 {
@@ -1114,6 +1171,13 @@ AudioSource::allocate_working_buffers (samplecnt_t framerate)
 	}
 }
 
+bool
+AudioSource::have_nested_sources ()
+{
+	Glib::Threads::Mutex::Lock lm (_level_buffer_lock);
+	return !_mixdown_buffers.empty ();
+}
+
 void
 AudioSource::ensure_buffers_for_level (uint32_t level, samplecnt_t sample_rate)
 {
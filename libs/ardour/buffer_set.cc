@@ -108,8 +108,15 @@ BufferSet::clear()
 void
 BufferSet::attach_buffers (PortSet& ports)
 {
-	const ChanCount& count (ports.count());
+	attach_buffers (ports.count ());
+}
 
+/** Set up this BufferSet as a mirror with @a count empty slots, which are
+ *  filled by set_mirror_buffer(). Not RT-safe.
+ */
+void
+BufferSet::attach_buffers (const ChanCount& count)
+{
 	clear ();
 
 	for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
@@ -118,9 +125,8 @@ BufferSet::attach_buffers (PortSet& ports)
 		v.assign (count.n (*t), (Buffer*) 0);
 	}
 
-	_count = ports.count();
-	_available = ports.count();
-
+	_count = count;
+	_available = count;
 
 	_is_mirror = true;
 }
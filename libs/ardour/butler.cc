@@ -23,14 +23,19 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <algorithm>
 
 #ifndef PLATFORM_WINDOWS
 #include <poll.h>
 #endif
 
+#include <boost/scoped_array.hpp>
+
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
 
+#include "ardour/audiosource.h"
 #include "ardour/butler.h"
 #include "ardour/debug.h"
 #include "ardour/disk_io.h"
@@ -54,9 +59,16 @@ Butler::Butler(Session& s)
 	, _audio_playback_buffer_size(0)
 	, _midi_buffer_size(0)
 	, pool_trash(16)
+	, _io_job (IORefill)
+	, _io_start ("butler_io_start", 0)
+	, _io_done ("butler_io_done", 0)
 	, _xthread (true)
 {
 	g_atomic_int_set(&should_do_transport_work, 0);
+	g_atomic_int_set (&_io_next, 0);
+	g_atomic_int_set (&_io_unfinished, 0);
+	g_atomic_int_set (&_io_errors, 0);
+	g_atomic_int_set (&_io_quit, 0);
 	SessionEvent::pool->set_trash (&pool_trash);
 
         /* catch future changes to parameters */
@@ -91,6 +103,8 @@ Butler::config_changed (std::string p)
 			_audio_capture_buffer_size = (uint32_t) floor (Config->get_audio_capture_buffer_seconds() * _session.sample_rate());
 			_session.adjust_capture_buffering ();
 		}
+	} else if (p == "playback-buffer-budget") {
+		_session.adjust_playback_buffering ();
 	} else if (p == "buffering-preset") {
 		DiskIOProcessor::set_buffering_parameters (Config->get_buffering_preset());
 		_audio_capture_buffer_size = (uint32_t) floor (Config->get_audio_capture_buffer_seconds() * _session.sample_rate());
@@ -127,6 +141,9 @@ Butler::start_thread()
 	//pthread_detach (thread);
 	have_thread = true;
 
+	/* changes to "disk-io-threads" take effect when the butler is restarted */
+	start_io_threads (io_thread_count ());
+
 	// we are ready to request buffer adjustments
 	_session.adjust_capture_buffering ();
 	_session.adjust_playback_buffering ();
@@ -143,6 +160,179 @@ Butler::terminate_thread ()
 		queue_request (Request::Quit);
 		pthread_join (thread, &status);
 	}
+	stop_io_threads ();
+}
+
+/** @return the number of disk I/O threads to use, some by default
+ * when capturing to FLAC, which is encoded while flushing.
+ */
+uint32_t
+Butler::io_thread_count () const
+{
+	uint32_t n = Config->get_disk_io_threads ();
+
+	if (n == 0 && _session.config.get_native_file_header_format () == FLAC) {
+		const uint32_t cpus = hardware_concurrency ();
+		n = std::max (1U, std::min (8U, cpus > 1 ? cpus - 1 : 1U));
+	}
+
+	return n;
+}
+
+/** Start the number of disk I/O threads which suits the session's
+ * current settings, e.g. after the session configuration was loaded.
+ */
+void
+Butler::reset_io_threads ()
+{
+	if (have_thread) {
+		queue_request (Request::IOThreads);
+	}
+}
+
+void
+Butler::start_io_threads (uint32_t n)
+{
+	g_atomic_int_set (&_io_quit, 0);
+
+	for (uint32_t i = 0; i < n; ++i) {
+		pthread_t t;
+		if (pthread_create_and_store ("disk io", &t, _io_thread_work, this)) {
+			warning << string_compose (_("Butler: could not create disk I/O thread %1"), i) << endmsg;
+			break;
+		}
+		_io_threads.push_back (t);
+	}
+
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("started %1 disk I/O threads\n", _io_threads.size ()));
+}
+
+void
+Butler::stop_io_threads ()
+{
+	g_atomic_int_set (&_io_quit, 1);
+
+	for (size_t i = 0; i < _io_threads.size (); ++i) {
+		_io_start.signal ();
+	}
+	for (std::vector<pthread_t>::iterator i = _io_threads.begin (); i != _io_threads.end (); ++i) {
+		void* status;
+		pthread_join (*i, &status);
+	}
+	_io_threads.clear ();
+}
+
+void*
+Butler::_io_thread_work (void* arg)
+{
+	SessionEvent::create_per_thread_pool ("disk io events", 64);
+	pthread_set_name (X_("disk io"));
+	((Butler *) arg)->io_thread_work ();
+	return 0;
+}
+
+void
+Butler::io_thread_work ()
+{
+	/* see DiskReader::allocate_working_buffers */
+	boost::scoped_array<Sample> sum_buf (new Sample[2 * 1048576]);
+	boost::scoped_array<Sample> mix_buf (new Sample[2 * 1048576]);
+	boost::scoped_array<gain_t> gain_buf (new gain_t[2 * 1048576]);
+
+	while (true) {
+		_io_start.wait ();
+		if (g_atomic_int_get (&_io_quit)) {
+			break;
+		}
+		process_io_jobs (sum_buf.get (), mix_buf.get (), gain_buf.get ());
+		_io_done.signal ();
+	}
+}
+
+/** Refill or flush @a tracks using the butler thread and all disk I/O threads.
+ * @return true if there is outstanding disk work
+ */
+bool
+Butler::run_io_jobs (IOJob job, std::vector<boost::shared_ptr<Track> > const& tracks, uint32_t& errors)
+{
+	if (tracks.empty ()) {
+		return false;
+	}
+
+	_io_tracks = tracks;
+	_io_job    = job;
+	g_atomic_int_set (&_io_next, 0);
+	g_atomic_int_set (&_io_unfinished, 0);
+	g_atomic_int_set (&_io_errors, 0);
+
+	/* wake up helpers, and take part in the work ourselves */
+	const size_t n_helpers = std::min (_io_threads.size (), tracks.size () - 1);
+
+	for (size_t i = 0; i < n_helpers; ++i) {
+		_io_start.signal ();
+	}
+
+	process_io_jobs (0, 0, 0);
+
+	for (size_t i = 0; i < n_helpers; ++i) {
+		_io_done.wait ();
+	}
+
+	_io_tracks.clear ();
+
+	errors += g_atomic_int_get (&_io_errors);
+
+	/* tracks that were not handled because transport work was requested
+	 * count as outstanding work */
+	return g_atomic_int_get (&_io_unfinished) > 0 || g_atomic_int_get (&_io_next) < (gint) tracks.size ();
+}
+
+/** Called by the butler (with null buffers, using DiskReader's working buffers)
+ * and by each disk I/O thread (with its own buffers).
+ */
+void
+Butler::process_io_jobs (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer)
+{
+	while (!transport_work_requested () && should_run) {
+
+		const gint n = g_atomic_int_add (&_io_next, 1);
+
+		if (n >= (gint) _io_tracks.size ()) {
+			break;
+		}
+
+		boost::shared_ptr<Track> tr = _io_tracks[n];
+
+		switch (_io_job) {
+		case IORefill:
+			switch (sum_buffer ? tr->do_refill (sum_buffer, mixdown_buffer, gain_buffer) : tr->do_refill ()) {
+			case 0:
+				break;
+			case 1:
+				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
+				g_atomic_int_inc (&_io_unfinished);
+				break;
+			default:
+				error << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << endmsg;
+				break;
+			}
+			break;
+
+		case IOFlush:
+			switch (tr->do_flush (ButlerContext, false)) {
+			case 0:
+				break;
+			case 1:
+				g_atomic_int_inc (&_io_unfinished);
+				break;
+			default:
+				g_atomic_int_inc (&_io_errors);
+				error << string_compose(_("Butler write-behind failure on dstream %1"), tr->name()) << endmsg;
+				break;
+			}
+			break;
+		}
+	}
 }
 
 void *
@@ -183,6 +373,11 @@ Butler::thread_work ()
 						should_run = false;
 						break;
 
+					case Request::IOThreads:
+						stop_io_threads ();
+						start_io_threads (io_thread_count ());
+						break;
+
 					case Request::Quit:
 						DEBUG_TRACE (DEBUG::Butler, string_compose ("%1: butler asked to quit @ %2\n", DEBUG_THREAD_SELF, g_get_monotonic_time()));
 						return 0;
@@ -234,38 +429,63 @@ Butler::thread_work ()
 
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("butler starts refill loop, twr = %1\n", transport_work_requested()));
 
-		for (i = rl_with_auditioner.begin(); !transport_work_requested() && should_run && i != rl_with_auditioner.end(); ++i) {
+		/* concurrent refill is only used if asked for, helpers
+		 * started for FLAC capture only flush */
+		if (Config->get_disk_io_threads () > 0 && !_io_threads.empty () && !AudioSource::have_nested_sources ()) {
 
-			boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+			std::vector<boost::shared_ptr<Track> > tracks;
 
-			if (!tr) {
-				continue;
+			for (i = rl_with_auditioner.begin(); i != rl_with_auditioner.end(); ++i) {
+				boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+				if (!tr) {
+					continue;
+				}
+				boost::shared_ptr<IO> io = tr->input ();
+				if (io && !io->active()) {
+					/* don't read inactive tracks */
+					continue;
+				}
+				tracks.push_back (tr);
 			}
 
-			boost::shared_ptr<IO> io = tr->input ();
+			uint32_t refill_errors = 0; // logged, but not fatal
+			disk_work_outstanding = run_io_jobs (IORefill, tracks, refill_errors);
 
-			if (io && !io->active()) {
-				/* don't read inactive tracks */
-				// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
-				continue;
-			}
-			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
-			switch (tr->do_refill ()) {
-			case 0:
-				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
-				break;
+		} else {
 
-			case 1:
-				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
-				disk_work_outstanding = true;
-				break;
+			for (i = rl_with_auditioner.begin(); !transport_work_requested() && should_run && i != rl_with_auditioner.end(); ++i) {
 
-			default:
-				error << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << endmsg;
-                                std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << std::endl;
-				break;
-			}
+				boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+
+				if (!tr) {
+					continue;
+				}
+
+				boost::shared_ptr<IO> io = tr->input ();
 
+				if (io && !io->active()) {
+					/* don't read inactive tracks */
+					// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
+					continue;
+				}
+				// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
+				switch (tr->do_refill ()) {
+				case 0:
+					//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
+					break;
+
+				case 1:
+					DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
+					disk_work_outstanding = true;
+					break;
+
+				default:
+					error << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << endmsg;
+	                                std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << std::endl;
+					break;
+				}
+
+			}
 		}
 
 		if (i != rl_with_auditioner.begin() && i != rl_with_auditioner.end()) {
@@ -322,6 +542,17 @@ Butler::flush_tracks_to_disk_normal (boost::shared_ptr<RouteList> rl, uint32_t&
 {
 	bool disk_work_outstanding = false;
 
+	if (!_io_threads.empty ()) {
+		std::vector<boost::shared_ptr<Track> > tracks;
+		for (RouteList::iterator i = rl->begin(); i != rl->end(); ++i) {
+			boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+			if (tr) {
+				tracks.push_back (tr);
+			}
+		}
+		return run_io_jobs (IOFlush, tracks, errors);
+	}
+
 	for (RouteList::iterator i = rl->begin(); !transport_work_requested() && should_run && i != rl->end(); ++i) {
 
 		// cerr << "write behind for " << (*i)->name () << endl;
@@ -0,0 +1,298 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/scoped_array.hpp>
+
+#include <glibmm/miscutils.h>
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+#include "pbd/gstdio_compat.h"
+#include "pbd/pthread_utils.h"
+
+#include "ardour/audiofilesource.h"
+#include "ardour/debug.h"
+#include "ardour/decoded_audio_cache.h"
+
+#include "pbd/i18n.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+Glib::Threads::Mutex DecodedAudioCache::active_lock;
+Glib::Threads::Mutex DecodedAudioCache::queue_lock;
+Glib::Threads::Cond  DecodedAudioCache::SourcesToDecode;
+list<boost::weak_ptr<AudioFileSource> > DecodedAudioCache::decode_queue;
+gint DecodedAudioCache::abort_decode = 0;
+
+namespace {
+
+const char        decoded_magic[8] = { 'A', 'R', 'D', 'O', 'U', 'R', 'D', '1' };
+const samplecnt_t decode_chunk     = 65536;
+
+/** Fixed size header at the start of each decoded file; the remainder of
+ * the header (up to DecodedAudioCache::header_size) is zero.
+ */
+struct DecodedHeader {
+	char    magic[8];
+	int64_t mtime;
+	int64_t size;
+	int64_t length;
+	float   gain;
+	float   rate;
+};
+
+bool
+describe_source (boost::shared_ptr<AudioFileSource> src, DecodedHeader& h)
+{
+	GStatBuf sb;
+
+	if (g_stat (src->decoded_origin ().c_str (), &sb)) {
+		return false;
+	}
+
+	memset (&h, 0, sizeof (h));
+	memcpy (h.magic, decoded_magic, sizeof (h.magic));
+	h.mtime  = sb.st_mtime;
+	h.size   = sb.st_size;
+	h.length = src->readable_length ();
+	h.gain   = src->gain ();
+	h.rate   = src->sample_rate ();
+	return true;
+}
+
+bool
+write_all (int fd, void const* buf, size_t bytes)
+{
+	char const* p = static_cast<char const*> (buf);
+
+	while (bytes > 0) {
+		ssize_t n = ::write (fd, p, bytes);
+		if (n <= 0) {
+			return false;
+		}
+		p     += n;
+		bytes -= n;
+	}
+	return true;
+}
+
+}
+
+static void
+decoded_audio_cache_work ()
+{
+	pthread_set_name ("AudioDecoder");
+	DecodedAudioCache::work ();
+}
+
+void
+DecodedAudioCache::init ()
+{
+#ifndef PLATFORM_WINDOWS
+	Glib::Threads::Thread::create (sigc::ptr_fun (decoded_audio_cache_work));
+#endif
+}
+
+void
+DecodedAudioCache::queue (boost::shared_ptr<AudioFileSource> src)
+{
+	if (!src) {
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock lm (queue_lock);
+	decode_queue.push_back (boost::weak_ptr<AudioFileSource> (src));
+	SourcesToDecode.broadcast ();
+}
+
+void
+DecodedAudioCache::work ()
+{
+	while (true) {
+		queue_lock.lock ();
+
+	  wait:
+		if (decode_queue.empty ()) {
+			SourcesToDecode.wait (queue_lock);
+		}
+
+		if (decode_queue.empty ()) {
+			goto wait;
+		}
+
+		boost::shared_ptr<AudioFileSource> src (decode_queue.front ().lock ());
+		decode_queue.pop_front ();
+		queue_lock.unlock ();
+
+		if (src) {
+			Glib::Threads::Mutex::Lock lm (active_lock);
+			decode (src);
+		}
+	}
+}
+
+void
+DecodedAudioCache::flush ()
+{
+	g_atomic_int_set (&abort_decode, 1);
+	{
+		Glib::Threads::Mutex::Lock lq (queue_lock);
+		Glib::Threads::Mutex::Lock la (active_lock);
+		decode_queue.clear ();
+	}
+	g_atomic_int_set (&abort_decode, 0);
+}
+
+/** @return a descriptor for @param path if it holds decoded data matching
+ * the current state of @param src, otherwise -1.
+ */
+int
+DecodedAudioCache::open_valid (string const& path, boost::shared_ptr<AudioFileSource> src)
+{
+	DecodedHeader expected;
+	DecodedHeader found;
+	GStatBuf      sb;
+
+	if (!describe_source (src, expected)) {
+		return -1;
+	}
+
+	int fd = g_open (path.c_str (), O_RDONLY, 0444);
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	if (::pread (fd, &found, sizeof (found), 0) != (ssize_t) sizeof (found)
+	    || fstat (fd, &sb)
+	    || memcmp (&found, &expected, sizeof (found))
+	    || sb.st_size != (off_t) (header_size + expected.length * sizeof (Sample))) {
+		::close (fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+void
+DecodedAudioCache::decode (boost::shared_ptr<AudioFileSource> src)
+{
+	const string path = src->decoded_cache_path ();
+	int          fd   = open_valid (path, src);
+
+	if (fd >= 0) {
+		DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("using decoded data for %1 from %2\n", src->name (), path));
+		src->set_decoded_cache (fd);
+		return;
+	}
+
+	DecodedHeader h;
+
+	if (!describe_source (src, h) || g_mkdir_with_parents (Glib::path_get_dirname (path).c_str (), 0755)) {
+		src->set_decoded_cache (-1);
+		return;
+	}
+
+	/* write to a temporary file, with an empty header until the data is
+	 * complete, then move it into place.
+	 */
+
+	const string tmp = path + X_(".tmp");
+
+	fd = g_open (tmp.c_str (), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+
+	if (fd < 0) {
+		error << string_compose (_("Cannot create decoded audio file %1 (%2)"), tmp, strerror (errno)) << endmsg;
+		src->set_decoded_cache (-1);
+		return;
+	}
+
+	char header[header_size];
+	memset (header, 0, sizeof (header));
+
+	boost::scoped_array<Sample> buf (new Sample[decode_chunk]);
+	bool                        ok  = write_all (fd, header, sizeof (header));
+	samplepos_t                 pos = 0;
+
+	while (ok && pos < h.length) {
+
+		if (g_atomic_int_get (&abort_decode)) {
+			ok = false;
+			break;
+		}
+
+		const samplecnt_t n = min (decode_chunk, (samplecnt_t) h.length - pos);
+		samplecnt_t       got;
+
+		{
+			Glib::Threads::Mutex::Lock lm (src->mutex ());
+			/* bypass the block cache and any decoded data */
+			got = src->read_unlocked (buf.get (), pos, n);
+		}
+
+		if (got <= 0) {
+			ok = false;
+			break;
+		}
+		if (got < n) {
+			memset (buf.get () + got, 0, sizeof (Sample) * (n - got));
+		}
+
+		ok   = write_all (fd, buf.get (), n * sizeof (Sample));
+		pos += n;
+	}
+
+	if (ok) {
+		memcpy (header, &h, sizeof (h));
+		ok = ::pwrite (fd, header, sizeof (header), 0) == (ssize_t) sizeof (header);
+	}
+
+	if (::close (fd)) {
+		ok = false;
+	}
+
+	DecodedHeader now;
+
+	if (ok && describe_source (src, now) && memcmp (&now, &h, sizeof (h))) {
+		/* the gain was changed while decoding (which dropped the source's
+		 * state), decode again unless a reader already queued it */
+		::g_unlink (tmp.c_str ());
+		if (g_atomic_int_compare_and_exchange (&src->_decoded_state, AudioFileSource::DecodedUnknown, AudioFileSource::DecodedQueued)) {
+			queue (src);
+		}
+		return;
+	}
+
+	if (!ok || ::g_rename (tmp.c_str (), path.c_str ())) {
+		::g_unlink (tmp.c_str ());
+		src->set_decoded_cache (-1);
+		return;
+	}
+
+	DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("decoded %1 to %2\n", src->name (), path));
+
+	src->set_decoded_cache (open_valid (path, src));
+}
@@ -35,6 +35,7 @@ const char* const dead_dir_name = X_("dead");
 const char* const interchange_dir_name = X_("interchange");
 const char* const export_dir_name = X_("export");
 const char* const backup_dir_name = X_("backup");
+const char* const decoded_dir_name = X_("decoded");
 const char* const export_formats_dir_name = X_("export");
 const char* const templates_dir_name = X_("templates");
 const char* const plugin_metadata_dir_name = X_("plugin_metadata");
@@ -17,6 +17,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cstring>
+
 #include "pbd/debug.h"
 #include "pbd/error.h"
 #include "pbd/playback_buffer.h"
@@ -48,6 +50,85 @@ const string DiskIOProcessor::state_node_name = X_("DiskIOProcessor");
 // PBD::Signal0<void> DiskIOProcessor::DiskOverrun;
 // PBD::Signal0<void>  DiskIOProcessor::DiskUnderrun;
 
+void
+DiskIOStats::reset ()
+{
+	ops          = 0;
+	bytes        = 0;
+	io_usec      = 0;
+	total_usec   = 0;
+	max_usec     = 0;
+	min_headroom = 1.f;
+	memset (buckets, 0, sizeof (buckets));
+}
+
+uint64_t
+DiskIOStats::bucket_limit (int b)
+{
+	/* 250us, 500us, 1ms .. 256ms, more */
+	return b < n_buckets - 1 ? (uint64_t) 250 << b : 0;
+}
+
+void
+DiskIOStats::add (uint64_t n_bytes, uint64_t io, uint64_t total)
+{
+	++ops;
+	bytes      += n_bytes;
+	io_usec    += io;
+	total_usec += total;
+	max_usec    = max (max_usec, total);
+
+	int b = 0;
+	while (b < n_buckets - 1 && total > bucket_limit (b)) {
+		++b;
+	}
+	++buckets[b];
+}
+
+void
+DiskIOStats::note_headroom (float h)
+{
+	min_headroom = min (min_headroom, h);
+}
+
+void
+DiskIOStats::merge (DiskIOStats const& other)
+{
+	ops          += other.ops;
+	bytes        += other.bytes;
+	io_usec      += other.io_usec;
+	total_usec   += other.total_usec;
+	max_usec      = max (max_usec, other.max_usec);
+	min_headroom  = min (min_headroom, other.min_headroom);
+	for (int b = 0; b < n_buckets; ++b) {
+		buckets[b] += other.buckets[b];
+	}
+}
+
+double
+DiskIOStats::percentile (double p) const
+{
+	if (ops == 0) {
+		return 0;
+	}
+
+	const double rank = ops * max (0.0, min (100.0, p)) / 100.0;
+	uint64_t     seen = 0;
+	uint64_t     lo   = 0;
+
+	for (int b = 0; b < n_buckets; ++b) {
+		const uint64_t hi = bucket_limit (b) > 0 ? bucket_limit (b) : max_usec;
+		if (buckets[b] > 0 && seen + buckets[b] >= rank) {
+			/* interpolate linearly within the bucket */
+			const double v = lo + (hi - lo) * (rank - seen) / (double) buckets[b];
+			return min ((double) max_usec, v);
+		}
+		seen += buckets[b];
+		lo    = hi;
+	}
+	return max_usec;
+}
+
 DiskIOProcessor::DiskIOProcessor (Session& s, string const & str, Flag f)
 	: Processor (s, str)
 	, _flags (f)
@@ -93,6 +174,30 @@ DiskIOProcessor::init ()
 	set_block_size (_session.get_block_size());
 }
 
+DiskIOStats
+DiskIOProcessor::io_stats () const
+{
+	Glib::Threads::Mutex::Lock lm (_io_stats_lock);
+	return _io_stats;
+}
+
+void
+DiskIOProcessor::reset_io_stats ()
+{
+	Glib::Threads::Mutex::Lock lm (_io_stats_lock);
+	_io_stats.reset ();
+}
+
+void
+DiskIOProcessor::record_io (uint64_t bytes, uint64_t io_usec, uint64_t total_usec, float headroom)
+{
+	Glib::Threads::Mutex::Lock lm (_io_stats_lock);
+	_io_stats.note_headroom (headroom);
+	if (bytes > 0) {
+		_io_stats.add (bytes, io_usec, total_usec);
+	}
+}
+
 void
 DiskIOProcessor::set_buffering_parameters (BufferingPreset bp)
 {
@@ -29,6 +29,7 @@
 #include "ardour/audio_buffer.h"
 #include "ardour/audioengine.h"
 #include "ardour/audioplaylist.h"
+#include "ardour/audioregion.h"
 #include "ardour/butler.h"
 #include "ardour/debug.h"
 #include "ardour/disk_reader.h"
@@ -64,6 +65,10 @@ DiskReader::DiskReader (Session& s, string const& str, DiskIOProcessor::Flag f)
 	, _declick_amp (s.nominal_sample_rate ())
 	, _declick_offs (0)
 	, _declick_enabled (false)
+	, _buffer_size (0)
+	, _planned_buffer_size (0)
+	, _read_cost (0)
+	, _playback_silent (false)
 {
 	file_sample[DataType::AUDIO] = 0;
 	file_sample[DataType::MIDI]  = 0;
@@ -105,7 +110,7 @@ int
 DiskReader::add_channel_to (boost::shared_ptr<ChannelList> c, uint32_t how_many)
 {
 	while (how_many--) {
-		c->push_back (new ReaderChannelInfo (_session.butler ()->audio_playback_buffer_size (), loop_fade_length));
+		c->push_back (new ReaderChannelInfo (playback_buffer_size (), loop_fade_length));
 		DEBUG_TRACE (DEBUG::DiskIO, string_compose ("%1: new reader channel, write space = %2 read = %3\n",
 		                                            name (),
 		                                            c->back ()->rbuf->write_space (),
@@ -224,9 +229,113 @@ DiskReader::adjust_buffering ()
 {
 	boost::shared_ptr<ChannelList> c = channels.reader ();
 
+	_buffer_size = _planned_buffer_size;
+
 	for (ChannelList::iterator chan = c->begin (); chan != c->end (); ++chan) {
-		(*chan)->resize (_session.butler ()->audio_playback_buffer_size ());
+		(*chan)->resize (playback_buffer_size ());
+	}
+}
+
+samplecnt_t
+DiskReader::playback_buffer_size () const
+{
+	if (_buffer_size > 0) {
+		return _buffer_size;
+	}
+	return _session.butler ()->audio_playback_buffer_size ();
+}
+
+bool
+DiskReader::drop_behind_range (samplepos_t read_start, samplecnt_t read_cnt, samplecnt_t keep, bool looping,
+                               samplepos_t& start, samplecnt_t& cnt)
+{
+	if (looping || read_start <= keep) {
+		return false;
+	}
+
+	start = max ((samplepos_t) 0, read_start - keep - read_cnt);
+	cnt   = read_start - keep - start;
+
+	return cnt > 0;
+}
+
+bool
+DiskReader::plan_buffer_sizes (std::vector<float> const& demand, std::vector<uint32_t> const& channels,
+                               double budget, samplecnt_t preset, std::vector<samplecnt_t>& sizes)
+{
+	assert (demand.size () == channels.size ());
+
+	double   total  = 0;
+	uint32_t n_chan = 0;
+
+	for (size_t n = 0; n < demand.size (); ++n) {
+		total  += demand[n] * channels[n];
+		n_chan += channels[n];
+	}
+
+	samplecnt_t       min_size = preset / 4;
+	const samplecnt_t max_size = preset * 2;
+	bool              fits     = true;
+
+	if (n_chan > 0 && n_chan * (double) min_size > budget) {
+		min_size = (samplecnt_t) (budget / n_chan);
+		fits     = false;
+	}
+
+	/* every channel gets the minimum, the remainder is split by demand */
+	const double spare = budget - n_chan * (double) min_size;
+
+	sizes.resize (demand.size ());
+
+	for (size_t n = 0; n < demand.size (); ++n) {
+		const samplecnt_t size = min_size + (total > 0 ? (samplecnt_t) (spare * demand[n] / total) : 0);
+		sizes[n] = std::min (max_size, size);
+	}
+
+	return fits;
+}
+
+/** @return the minimum amount of space to refill at once. Readers
+ * with a smaller or larger than default buffer refill proportionally
+ * smaller or larger chunks.
+ */
+samplecnt_t
+DiskReader::refill_chunk () const
+{
+	const samplecnt_t preset = _session.butler ()->audio_playback_buffer_size ();
+
+	if (_buffer_size == 0 || preset <= 0) {
+		return _chunk_samples;
 	}
+
+	return max ((samplecnt_t) 1, (samplecnt_t) (_chunk_samples * (double) _buffer_size / preset));
+}
+
+static void
+add_region_length (boost::shared_ptr<Region> r, samplecnt_t* total)
+{
+	*total += r->length ();
+}
+
+float
+DiskReader::playlist_density () const
+{
+	boost::shared_ptr<Playlist> pl = _playlists[DataType::AUDIO];
+
+	if (!pl || pl->n_regions () == 0) {
+		return 0;
+	}
+
+	const std::pair<samplepos_t, samplepos_t> extent = pl->get_extent ();
+
+	if (extent.second <= extent.first) {
+		return 0;
+	}
+
+	samplecnt_t total = 0;
+	pl->foreach_region (boost::bind (&add_region_length, _1, &total));
+
+	return total / (float) (extent.second - extent.first);
 }
 
 void
@@ -269,6 +378,8 @@ DiskReader::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 	MonitorState                   ms = _track->monitoring_state ();
 	const bool                     midi_only = (c->empty() || !_playlists[DataType::AUDIO]);
 
+	_playback_silent = false;
+
 	if (_active) {
 		if (!_pending_active) {
 			_active = false;
@@ -379,6 +490,7 @@ DiskReader::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 
 		const float          initial_declick_gain = _declick_amp.gain ();
 		const sampleoffset_t declick_offs         = _declick_offs;
+		bool                 all_silent           = (ms == MonitoringDisk) && !declick_out && disk_samples_to_consume > 0;
 
 		for (n = 0, chan = c->begin (); chan != c->end (); ++chan, ++n) {
 			ReaderChannelInfo* chaninfo = dynamic_cast<ReaderChannelInfo*> (*chan);
@@ -403,7 +515,15 @@ DiskReader::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 			/* reset _declick_amp to the correct gain before processing this channel. */
 			_declick_amp.set_gain (initial_declick_gain);
 
-			if (!declick_out) {
+			bool chan_silent = false;
+
+			if (!declick_out && disk_samples_to_consume > 0 && chaninfo->rbuf->is_silent (disk_samples_to_consume)) {
+				/* the refill found no regions here, no need to copy silence */
+				chaninfo->rbuf->increment_read_ptr (disk_samples_to_consume);
+				disk_buf.silence (disk_samples_to_consume);
+				chan_silent = true;
+
+			} else if (!declick_out) {
 				const samplecnt_t available = chaninfo->rbuf->read (disk_buf.data (), disk_samples_to_consume);
 
 				if (available == 0 && !chaninfo->initialized) {
@@ -438,6 +558,12 @@ DiskReader::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 
 			/* _declick_amp is now left with the correct gain after processing nframes */
 
+			all_silent = all_silent && chan_silent;
+
+			if (chan_silent) {
+				continue;
+			}
+
 			Amp::apply_simple_gain (disk_buf, nframes, scaling);
 
 			if (ms & MonitoringInput) {
@@ -445,6 +571,8 @@ DiskReader::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 				mix_buffers_no_gain (output.data (), disk_buf.data (), nframes);
 			}
 		}
+
+		_playback_silent = all_silent && !_playlists[DataType::MIDI];
 	}
 
 midi:
@@ -491,9 +619,9 @@ midi:
 						butler_required = true;
 					}
 				} else {
-					if ((samplecnt_t)c->front ()->rbuf->write_space () >= _chunk_samples) {
+					if ((samplecnt_t)c->front ()->rbuf->write_space () >= refill_chunk ()) {
 						DEBUG_TRACE (DEBUG::Butler, string_compose ("%1: write space = %2 of %3\n", name (), c->front ()->rbuf->write_space (),
-						                                            _chunk_samples));
+						                                            refill_chunk ()));
 						butler_required = true;
 					}
 				}
@@ -708,6 +836,8 @@ DiskReader::overwrite_existing_audio ()
 		Sample*            buf = (*chan)->rbuf->buffer ();
 		ReaderChannelInfo* rci = dynamic_cast<ReaderChannelInfo*> (*chan);
 
+		(*chan)->rbuf->clear_silence ();
+
 		if (chunk1_cnt) {
 			if (audio_read (buf + chunk1_offset, mixdown_buffer.get (), gain_buffer.get (), start, chunk1_cnt, rci, n, reversed) != chunk1_cnt) {
 				error << string_compose (_("DiskReader %1: when overwriting(1), cannot read %2 from playlist at sample %3"), id (), chunk1_cnt, overwrite_sample) << endmsg;
@@ -782,6 +912,87 @@ DiskReader::overwrite_existing_buffers ()
 	return ret;
 }
 
+void
+DiskReader::prefetch (samplepos_t sample)
+{
+	/* called via Session::non_realtime_locate() from butler thread,
+	 * for all tracks before any of them is refilled by seek() */
+
+	const samplecnt_t cnt = playback_buffer_size ();
+
+	if (_session.transport_will_roll_forwards ()) {
+		hint_audio_sources (sample, cnt, true);
+	} else {
+		hint_audio_sources (max ((samplepos_t) 0, sample - cnt), min ((samplecnt_t) sample, cnt), true);
+	}
+}
+
+/** Pass an access hint for the playlist range [start, start + cnt)
+ * on to the sources of all audio regions in that range.
+ */
+void
+DiskReader::hint_audio_sources (samplepos_t start, samplecnt_t cnt, bool willneed)
+{
+	boost::shared_ptr<Playlist> pl = _playlists[DataType::AUDIO];
+
+	if (!pl || cnt <= 0) {
+		return;
+	}
+
+	const samplepos_t end = start + cnt - 1;
+
+	boost::shared_ptr<RegionList> rl = pl->regions_touched (start, end);
+
+	for (RegionList::const_iterator r = rl->begin (); r != rl->end (); ++r) {
+		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*r);
+		if (!ar) {
+			continue;
+		}
+
+		const samplepos_t s = max (start, ar->position ());
+		const samplepos_t e = min (end, ar->last_sample ());
+
+		if (e < s) {
+			continue;
+		}
+
+		const samplepos_t src = ar->start () + (s - ar->position ());
+
+		for (uint32_t n = 0; n < ar->n_channels (); ++n) {
+			if (willneed) {
+				ar->audio_source (n)->readahead (src, e - s + 1);
+			} else {
+				ar->audio_source (n)->drop_cache (src, e - s + 1);
+			}
+		}
+	}
+}
+
+/** @return the number of samples, starting at @a start and at most @a cnt,
+ * before the first region of the audio playlist.
+ */
+samplecnt_t
+DiskReader::leading_silence (samplepos_t start, samplecnt_t cnt) const
+{
+	boost::shared_ptr<Playlist> pl = _playlists[DataType::AUDIO];
+
+	if (!pl || cnt <= 0) {
+		return 0;
+	}
+
+	boost::shared_ptr<RegionList> rl = pl->regions_touched (start, start + cnt - 1);
+	samplecnt_t                   gap = cnt;
+
+	for (RegionList::const_iterator r = rl->begin (); r != rl->end (); ++r) {
+		if ((*r)->position () <= start) {
+			return 0;
+		}
+		gap = min (gap, (*r)->position () - start);
+	}
+
+	return gap;
+}
+
 int
 DiskReader::seek (samplepos_t sample, bool complete_refill)
 {
@@ -1076,6 +1287,13 @@ DiskReader::do_refill ()
 	return refill (_sum_buffer, _mixdown_buffer, _gain_buffer, 0, reversed);
 }
 
+int
+DiskReader::do_refill (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer)
+{
+	const bool reversed = !_session.transport_will_roll_forwards ();
+	return refill (sum_buffer, mixdown_buffer, gain_buffer, 0, reversed);
+}
+
 int
 DiskReader::do_refill_with_alloc (bool partial_fill, bool reversed)
 {
@@ -1089,7 +1307,7 @@ DiskReader::do_refill_with_alloc (bool partial_fill, bool reversed)
 	boost::scoped_array<Sample> mix_buf (new Sample[2 * 1048576]);
 	boost::scoped_array<float>  gain_buf (new float[2 * 1048576]);
 
-	return refill_audio (sum_buf.get (), mix_buf.get (), gain_buf.get (), (partial_fill ? _chunk_samples : 0), reversed);
+	return refill_audio (sum_buf.get (), mix_buf.get (), gain_buf.get (), (partial_fill ? refill_chunk () : 0), reversed);
 }
 
 int
@@ -1146,6 +1364,7 @@ DiskReader::refill_audio (Sample* sum_buffer, Sample* mixdown_buffer, float* gai
 	assert (gain_buffer);
 
 	samplecnt_t total_space = c->front ()->rbuf->write_space ();
+	const float headroom    = 1.f - total_space / (float) c->front ()->rbuf->bufsize ();
 
 	if (total_space == 0) {
 		DEBUG_TRACE (DEBUG::DiskIO, string_compose ("%1: no space to refill\n", name ()));
@@ -1173,8 +1392,10 @@ DiskReader::refill_audio (Sample* sum_buffer, Sample* mixdown_buffer, float* gai
 	 * the playback buffer is empty.
 	 */
 
-	DEBUG_TRACE (DEBUG::DiskIO, string_compose ("%1: space to refill %2 vs. chunk %3 (speed = %4)\n", name (), total_space, _chunk_samples, _session.transport_speed ()));
-	if ((total_space < _chunk_samples) && fabs (_session.transport_speed ()) < 2.0f) {
+	const samplecnt_t chunk = refill_chunk ();
+
+	DEBUG_TRACE (DEBUG::DiskIO, string_compose ("%1: space to refill %2 vs. chunk %3 (speed = %4)\n", name (), total_space, chunk, _session.transport_speed ()));
+	if ((total_space < chunk) && fabs (_session.transport_speed ()) < 2.0f) {
 		return 0;
 	}
 
@@ -1246,10 +1467,20 @@ DiskReader::refill_audio (Sample* sum_buffer, Sample* mixdown_buffer, float* gai
 
 	samplepos_t file_sample_tmp = fsa;
 
-#if 0
-	int64_t before = g_get_monotonic_time ();
-	int64_t elapsed;
-#endif
+	samplecnt_t samples_read = 0;
+	int64_t     before       = g_get_monotonic_time ();
+	int64_t     read_elapsed = 0;
+	int64_t     elapsed;
+
+	/* a gap in the playlist at the start of this refill is written as
+	 * silence, without reading or mixing anything. The disk reader then
+	 * skips it when playing back.
+	 */
+	samplecnt_t silent_cnt = 0;
+
+	if (!reversed && !_loop_location) {
+		silent_cnt = leading_silence (fsa, min (total_space, samples_to_read));
+	}
 
 	for (chan_n = 0, i = c->begin (); i != c->end (); ++i, ++chan_n) {
 		ChannelInfo* chan (*i);
@@ -1275,16 +1506,32 @@ DiskReader::refill_audio (Sample* sum_buffer, Sample* mixdown_buffer, float* gai
 				chan->rbuf->write_zero (to_read);
 
 			} else {
-				samplecnt_t nread;
-				if ((nread = audio_read (sum_buffer, mixdown_buffer, gain_buffer, file_sample_tmp, to_read, rci, chan_n, reversed)) != to_read) {
-					error << string_compose (_("DiskReader %1: when refilling, cannot read %2 from playlist at sample %3"), name (), to_read, fsa) << endmsg;
-					ret = -1;
-					goto out;
+				const samplecnt_t gap = min (silent_cnt, to_read);
+
+				if (gap) {
+					chan->rbuf->write_zero (gap);
+					file_sample_tmp += gap;
 				}
 
-				if (chan->rbuf->write (sum_buffer, nread) != nread) {
-					error << string_compose (_("DiskReader %1: when refilling, cannot write %2 into buffer"), name (), nread) << endmsg;
-					ret = -1;
+				if (to_read > gap) {
+					samplecnt_t   nread;
+					const int64_t read_start = g_get_monotonic_time ();
+
+					nread         = audio_read (sum_buffer, mixdown_buffer, gain_buffer, file_sample_tmp, to_read - gap, rci, chan_n, reversed);
+					read_elapsed += g_get_monotonic_time () - read_start;
+
+					if (nread != to_read - gap) {
+						error << string_compose (_("DiskReader %1: when refilling, cannot read %2 from playlist at sample %3"), name (), to_read - gap, fsa + gap) << endmsg;
+						ret = -1;
+						goto out;
+					}
+
+					if (chan->rbuf->write (sum_buffer, nread) != nread) {
+						error << string_compose (_("DiskReader %1: when refilling, cannot write %2 into buffer"), name (), nread) << endmsg;
+						ret = -1;
+					}
+
+					samples_read += nread;
 				}
 			}
 			if (!rci->initialized) {
@@ -1301,15 +1548,41 @@ DiskReader::refill_audio (Sample* sum_buffer, Sample* mixdown_buffer, float* gai
 		}
 	}
 
-#if 0
 	elapsed = g_get_monotonic_time () - before;
+
+	record_io (samples_read * sizeof (Sample), read_elapsed, elapsed, headroom);
+
+	if (samples_read > 0) {
+		/* moving average of the read cost, used to distribute playback buffer space */
+		const float cost = elapsed / (float) samples_read;
+		_read_cost = _read_cost > 0 ? _read_cost + (cost - _read_cost) * 0.125f : cost;
+	}
+
+#if 0
 	cerr << '\t' << name() << ": bandwidth = " << (byte_size_for_read / 1048576.0) / (elapsed/1000000.0) << "MB/sec\n";
 #endif
 
 	file_sample[DataType::AUDIO] = file_sample_tmp;
 	assert (file_sample[DataType::AUDIO] >= 0);
 
-	ret = ((total_space - samples_to_read) > _chunk_samples);
+	/* let the OS read the next window while other tracks are refilled */
+	if (reversed) {
+		hint_audio_sources (max ((samplepos_t) 0, file_sample_tmp - samples_to_read), min (file_sample_tmp, samples_to_read), true);
+	} else {
+		hint_audio_sources (file_sample_tmp, samples_to_read, true);
+
+		samplepos_t drop_start;
+		samplecnt_t drop_cnt;
+
+		/* keep one playback buffer worth of data behind the
+		 * playhead cached, for short locates */
+		if (Config->get_disk_drop_behind () &&
+		    drop_behind_range (fsa, samples_to_read, c->front ()->rbuf->bufsize (), _last_read_loop.value_or (false), drop_start, drop_cnt)) {
+			hint_audio_sources (drop_start, drop_cnt, false);
+		}
+	}
+
+	ret = ((total_space - samples_to_read) > chunk);
 
 out:
 	return ret;
@@ -834,6 +834,12 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 	RingBufferNPT<Sample>::rw_vector vector;
 	samplecnt_t total;
 
+	const int64_t before        = g_get_monotonic_time ();
+	int64_t       write_elapsed = 0;
+	int64_t       write_start;
+	samplecnt_t   written       = 0;
+	float         headroom      = 1.f;
+
 	vector.buf[0] = 0;
 	vector.buf[1] = 0;
 
@@ -842,7 +848,8 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 
 		(*chan)->wbuf->get_read_vector (&vector);
 
-		total = vector.len[0] + vector.len[1];
+		total    = vector.len[0] + vector.len[1];
+		headroom = min (headroom, 1.f - total / (float) (*chan)->wbuf->bufsize ());
 
 		if (total == 0 || (total < _chunk_samples && !force_flush && _was_recording)) {
 			goto out;
@@ -865,11 +872,16 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 
 		to_write = min (_chunk_samples, (samplecnt_t) vector.len[0]);
 
+		write_start = g_get_monotonic_time ();
+
 		if ((!(*chan)->write_source) || (*chan)->write_source->write (vector.buf[0], to_write) != to_write) {
 			error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
 			return -1;
 		}
 
+		write_elapsed += g_get_monotonic_time () - write_start;
+		written       += to_write;
+
 		(*chan)->wbuf->increment_read_ptr (to_write);
 		(*chan)->curr_capture_cnt += to_write;
 
@@ -884,11 +896,16 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 
                         DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 additional write of %2\n", name(), to_write));
 
+			write_start = g_get_monotonic_time ();
+
 			if ((*chan)->write_source->write (vector.buf[1], to_write) != to_write) {
 				error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
 				return -1;
 			}
 
+			write_elapsed += g_get_monotonic_time () - write_start;
+			written       += to_write;
+
 			(*chan)->wbuf->increment_read_ptr (to_write);
 			(*chan)->curr_capture_cnt += to_write;
 		}
@@ -939,6 +956,7 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 	}
 
   out:
+	record_io (written * sizeof (Sample), write_elapsed, g_get_monotonic_time () - before, headroom);
 	return ret;
 
 }
@@ -51,6 +51,28 @@ ARDOUR::DSP::mmult (float *data, float *mult, const uint32_t n_samples) {
 	}
 }
 
+void
+ARDOUR::DSP::apply_gain_ramp (float *data, const float g0, const float g1, const uint32_t n_samples) {
+	if (n_samples == 0) {
+		return;
+	}
+	const float dg = (g1 - g0) / n_samples;
+	for (uint32_t i = 0; i < n_samples; ++i) {
+		data[i] *= g0 + i * dg;
+	}
+}
+
+void
+ARDOUR::DSP::mix_buffers_with_ramp (float *dst, const float *src, const float g0, const float g1, const uint32_t n_samples) {
+	if (n_samples == 0) {
+		return;
+	}
+	const float dg = (g1 - g0) / n_samples;
+	for (uint32_t i = 0; i < n_samples; ++i) {
+		dst[i] += src[i] * (g0 + i * dg);
+	}
+}
+
 float
 ARDOUR::DSP::log_meter (float power) {
 	// compare to libs/ardour/log_meter.h
@@ -0,0 +1,94 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "ardour/dsp_stats.h"
+
+using namespace ARDOUR;
+using namespace std;
+
+void
+DSPStats::reset ()
+{
+	cycles     = 0;
+	total_usec = 0;
+	min_usec   = 0;
+	max_usec   = 0;
+	memset (buckets, 0, sizeof (buckets));
+}
+
+uint64_t
+DSPStats::bucket_limit (int b)
+{
+	/* 1us, 2us, 4us .. 16.4ms, more */
+	return b < n_buckets - 1 ? (uint64_t) 1 << b : 0;
+}
+
+void
+DSPStats::add (uint64_t usec)
+{
+	min_usec = cycles > 0 ? min (min_usec, usec) : usec;
+	max_usec = max (max_usec, usec);
+	total_usec += usec;
+	++cycles;
+
+	int b = 0;
+	while (b < n_buckets - 1 && usec > bucket_limit (b)) {
+		++b;
+	}
+	++buckets[b];
+}
+
+void
+DSPStats::merge (DSPStats const& other)
+{
+	if (other.cycles == 0) {
+		return;
+	}
+	min_usec    = cycles > 0 ? min (min_usec, other.min_usec) : other.min_usec;
+	max_usec    = max (max_usec, other.max_usec);
+	total_usec += other.total_usec;
+	cycles     += other.cycles;
+	for (int b = 0; b < n_buckets; ++b) {
+		buckets[b] += other.buckets[b];
+	}
+}
+
+double
+DSPStats::percentile (double p) const
+{
+	if (cycles == 0) {
+		return 0;
+	}
+
+	const double rank = cycles * max (0.0, min (100.0, p)) / 100.0;
+	uint64_t     seen = 0;
+	uint64_t     lo   = 0;
+
+	for (int b = 0; b < n_buckets; ++b) {
+		const uint64_t hi = bucket_limit (b) > 0 ? bucket_limit (b) : max_usec;
+		if (buckets[b] > 0 && seen + buckets[b] >= rank) {
+			/* interpolate linearly within the bucket */
+			const double v = lo + (hi - lo) * (rank - seen) / (double) buckets[b];
+			return max ((double) min_usec, min ((double) max_usec, v));
+		}
+		seen += buckets[b];
+		lo    = hi;
+	}
+	return max_usec;
+}
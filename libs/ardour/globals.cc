@@ -106,6 +106,7 @@
 #include "ardour/audioregion.h"
 #include "ardour/buffer_manager.h"
 #include "ardour/control_protocol_manager.h"
+#include "ardour/decoded_audio_cache.h"
 #include "ardour/directory_names.h"
 #include "ardour/event_type_map.h"
 #include "ardour/filesystem_paths.h"
@@ -542,6 +543,7 @@ ARDOUR::init (bool use_windows_vst, bool try_optimization, const char* localedir
 
 	SourceFactory::init ();
 	Analyser::init ();
+	DecodedAudioCache::init ();
 
 	/* singletons - first object is "it" */
 	(void)PluginManager::instance ();
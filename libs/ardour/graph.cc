@@ -30,6 +30,7 @@
 #include "ardour/audioengine.h"
 #include "ardour/debug.h"
 #include "ardour/graph.h"
+#include "ardour/graphnode.h"
 #include "ardour/process_thread.h"
 #include "ardour/route.h"
 #include "ardour/session.h"
@@ -56,6 +57,40 @@ alloc_allowed ()
 
 #define g_atomic_uint_get(x) static_cast<guint> (g_atomic_int_get (x))
 
+/** upper bound for entries in the task-queue; run_tasks() falls back to
+ * running tasks itself rather than exceeding it. */
+static const guint max_queued_tasks = 256;
+
+/** A set of tasks handed to Graph::run_tasks(), on the caller's stack.
+ * It is queued once per helper thread; each thread that dequeues it
+ * claims tasks until none are left.
+ */
+struct Graph::TaskSet {
+	TaskSet (GraphTask** t, uint32_t n)
+		: tasks (t)
+		, n_tasks (n)
+	{
+		g_atomic_int_set (&next, 0);
+		g_atomic_int_set (&pending, 0);
+	}
+
+	void work ()
+	{
+		for (;;) {
+			const gint i = g_atomic_int_add (&next, 1);
+			if (i >= (gint) n_tasks) {
+				break;
+			}
+			tasks[i]->run ();
+		}
+	}
+
+	GraphTask**   tasks;
+	uint32_t      n_tasks;
+	volatile gint next;    ///< index of the next unclaimed task
+	volatile gint pending; ///< queue entries that have not been completed
+};
+
 Graph::Graph (Session& session)
 	: SessionHandleRef (session)
 	, _execution_sem ("graph_execution", 0)
@@ -71,12 +106,14 @@ Graph::Graph (Session& session)
 	g_atomic_int_set (&_n_workers, 0);
 	g_atomic_int_set (&_idle_thread_cnt, 0);
 	g_atomic_int_set (&_trigger_queue_size, 0);
+	g_atomic_int_set (&_task_queue_size, 0);
 
 	_n_terminal_nodes[0] = 0;
 	_n_terminal_nodes[1] = 0;
 
 	/* pre-allocate memory */
 	_trigger_queue.reserve (1024);
+	_task_queue.reserve (max_queued_tasks);
 
 	ARDOUR::AudioEngine::instance ()->Running.connect_same_thread (engine_connections, boost::bind (&Graph::reset_thread_list, this));
 	ARDOUR::AudioEngine::instance ()->Stopped.connect_same_thread (engine_connections, boost::bind (&Graph::engine_stopped, this));
@@ -433,6 +470,9 @@ Graph::run_one ()
 
 		g_atomic_int_dec_and_test (&_idle_thread_cnt);
 
+		/* help a node that is being processed by other threads */
+		while (run_queued_task ()) ;
+
 		/* Try to find some work to do */
 		_trigger_queue.pop_front (to_run);
 	}
@@ -444,6 +484,70 @@ Graph::run_one ()
 	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 has finished run_one()\n", pthread_name ()));
 }
 
+/** Run one entry of the task-queue, if any.
+ * Called by idle process threads, and by threads waiting in run_tasks().
+ */
+bool
+Graph::run_queued_task ()
+{
+	TaskSet* ts;
+
+	if (!_task_queue.pop_front (ts)) {
+		return false;
+	}
+
+	g_atomic_int_dec_and_test (&_task_queue_size);
+	ts->work ();
+	/* ts may vanish as soon as pending drops to zero */
+	g_atomic_int_dec_and_test (&ts->pending);
+	return true;
+}
+
+/** Run @a n_tasks independent tasks, spreading them over idle process
+ * threads. The calling thread takes part and this method returns once all
+ * tasks have completed. When called from outside the process threads, or
+ * if no thread is idle, the tasks are run in the calling thread.
+ *
+ * This is realtime-safe.
+ */
+void
+Graph::run_tasks (GraphTask** tasks, uint32_t n_tasks)
+{
+	if (n_tasks == 0) {
+		return;
+	}
+
+	TaskSet ts (tasks, n_tasks);
+	guint   helpers = 0;
+
+	if (n_tasks > 1 && in_process_thread ()) {
+		helpers = std::min (g_atomic_uint_get (&_idle_thread_cnt), (guint) n_tasks - 1);
+		if (g_atomic_uint_get (&_task_queue_size) + helpers > max_queued_tasks) {
+			helpers = 0;
+		}
+	}
+
+	if (helpers > 0) {
+		g_atomic_int_set (&ts.pending, helpers);
+		for (guint i = 0; i < helpers; ++i) {
+			g_atomic_int_inc (&_task_queue_size);
+			_task_queue.push_back (&ts);
+		}
+		for (guint i = 0; i < helpers; ++i) {
+			_execution_sem.signal ();
+		}
+	}
+
+	ts.work ();
+
+	/* wait for helpers, dequeueing entries ourselves when threads did not wake up in time */
+	while (g_atomic_int_get (&ts.pending) > 0) {
+		if (!run_queued_task ()) {
+			sched_yield ();
+		}
+	}
+}
+
 void
 Graph::helper_thread ()
 {
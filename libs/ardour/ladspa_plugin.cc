@@ -116,11 +116,6 @@ LadspaPlugin::init (string module_path, uint32_t index, samplecnt_t rate)
 
 	_index = index;
 
-	if (LADSPA_IS_INPLACE_BROKEN(_descriptor->Properties)) {
-		info << string_compose(_("LADSPA: \"%1\" cannot be used, since it cannot do inplace processing"), _descriptor->Name) << endmsg;
-		throw failed_constructor();
-	}
-
 	_sample_rate = rate;
 
 	if (_descriptor->instantiate == 0) {
@@ -668,12 +663,11 @@ LadspaPlugin::latency_compute_run ()
 	uint32_t out_index = 0;
 	const samplecnt_t bufsize = 1024;
 	LADSPA_Data buffer[bufsize];
+	LADSPA_Data out_buffer[bufsize];
 
 	memset(buffer,0,sizeof(LADSPA_Data)*bufsize);
 
-	/* Note that we've already required that plugins
-	   be able to handle in-place processing.
-	*/
+	/* separate output buffer, for plugins which are inplace-broken */
 
 	port_index = 0;
 
@@ -683,7 +677,7 @@ LadspaPlugin::latency_compute_run ()
 				connect_port (port_index, buffer);
 				in_index++;
 			} else if (LADSPA_IS_PORT_OUTPUT (port_descriptor (port_index))) {
-				connect_port (port_index, buffer);
+				connect_port (port_index, out_buffer);
 				out_index++;
 			}
 		}
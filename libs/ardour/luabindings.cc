@@ -50,6 +50,7 @@
 #include "ardour/delayline.h"
 #include "ardour/disk_reader.h"
 #include "ardour/disk_writer.h"
+#include "ardour/dsp_stats.h"
 #include "ardour/dsp_filter.h"
 #include "ardour/file_source.h"
 #include "ardour/filesystem_paths.h"
@@ -94,6 +95,7 @@
 #include "ardour/tempo.h"
 #include "ardour/vca.h"
 #include "ardour/vca_manager.h"
+#include "ardour/worker.h"
 
 #include "LuaBridge/LuaBridge.h"
 
@@ -751,6 +753,35 @@ LuaBindings::common (lua_State* L)
 		.beginClass <Progress> ("Progress")
 		.endClass ()
 
+		.beginClass <DiskIOStats> ("DiskIOStats")
+		.addVoidConstructor ()
+		.addFunction ("reset", &DiskIOStats::reset)
+		.addFunction ("merge", &DiskIOStats::merge)
+		.addFunction ("percentile", &DiskIOStats::percentile)
+		.addFunction ("histogram", &DiskIOStats::histogram)
+		.addStaticFunction ("bucket_limit", &DiskIOStats::bucket_limit)
+		.addData ("ops", &DiskIOStats::ops, false)
+		.addData ("bytes", &DiskIOStats::bytes, false)
+		.addData ("io_usec", &DiskIOStats::io_usec, false)
+		.addData ("total_usec", &DiskIOStats::total_usec, false)
+		.addData ("max_usec", &DiskIOStats::max_usec, false)
+		.addData ("min_headroom", &DiskIOStats::min_headroom, false)
+		.endClass ()
+
+		.beginClass <DSPStats> ("DSPStats")
+		.addVoidConstructor ()
+		.addFunction ("reset", &DSPStats::reset)
+		.addFunction ("merge", &DSPStats::merge)
+		.addFunction ("avg_usec", &DSPStats::avg_usec)
+		.addFunction ("percentile", &DSPStats::percentile)
+		.addFunction ("histogram", &DSPStats::histogram)
+		.addStaticFunction ("bucket_limit", &DSPStats::bucket_limit)
+		.addData ("cycles", &DSPStats::cycles, false)
+		.addData ("total_usec", &DSPStats::total_usec, false)
+		.addData ("min_usec", &DSPStats::min_usec, false)
+		.addData ("max_usec", &DSPStats::max_usec, false)
+		.endClass ()
+
 		.beginClass <MusicSample> ("MusicSample")
 		.addConstructor <void (*) (samplepos_t, int32_t)> ()
 		.addFunction ("set", &MusicSample::set)
@@ -1114,6 +1145,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("set_meter_point", &Route::set_meter_point)
 		.addFunction ("signal_latency", &Route::signal_latency)
 		.addFunction ("playback_latency", &Route::playback_latency)
+		.addFunction ("dsp_stats", &Route::dsp_stats)
+		.addFunction ("reset_dsp_stats", &Route::reset_dsp_stats)
 		.endClass ()
 
 		.deriveWSPtrClass <Playlist, SessionObject> ("Playlist")
@@ -1191,6 +1224,9 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("use_copy_playlist", &Track::use_copy_playlist)
 		.addFunction ("use_new_playlist", &Track::use_new_playlist)
 		.addFunction ("find_and_use_playlist", &Track::find_and_use_playlist)
+		.addFunction ("playback_io_stats", &Track::playback_io_stats)
+		.addFunction ("capture_io_stats", &Track::capture_io_stats)
+		.addFunction ("reset_io_stats", &Track::reset_io_stats)
 		.endClass ()
 
 		.deriveWSPtrClass <AudioTrack, Track> ("AudioTrack")
@@ -1440,6 +1476,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("output_streams", &Processor::output_streams)
 		.addFunction ("input_streams", &Processor::input_streams)
 		.addFunction ("signal_latency", &Processor::signal_latency)
+		.addFunction ("dsp_stats", &Processor::dsp_stats)
+		.addFunction ("reset_dsp_stats", &Processor::reset_dsp_stats)
 		.endClass ()
 
 		.deriveWSPtrClass <DiskIOProcessor, Processor> ("DiskIOProcessor")
@@ -2337,6 +2375,7 @@ LuaBindings::common (lua_State* L)
 
 		// we could use addProperty ()
 		.addFunction ("config", &_libardour_config)
+		.addFunction ("lv2_worker_stats", &Worker::pool_stats)
 
 		.endNamespace ();
 
@@ -2363,6 +2402,11 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("get_play_loop", &Session::get_play_loop)
 		.addFunction ("get_xrun_count", &Session::get_xrun_count)
 		.addFunction ("reset_xrun_count", &Session::reset_xrun_count)
+		.addFunction ("playback_io_stats", &Session::playback_io_stats)
+		.addFunction ("capture_io_stats", &Session::capture_io_stats)
+		.addFunction ("reset_io_stats", &Session::reset_io_stats)
+		.addFunction ("dsp_stats", &Session::dsp_stats)
+		.addFunction ("reset_dsp_stats", &Session::reset_dsp_stats)
 		.addFunction ("last_transport_start", &Session::last_transport_start)
 		.addFunction ("goto_start", &Session::goto_start)
 		.addFunction ("goto_end", &Session::goto_end)
@@ -2535,6 +2579,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("accurate_coefficient_to_dB", &accurate_coefficient_to_dB)
 		.addFunction ("memset", &DSP::memset)
 		.addFunction ("mmult", &DSP::mmult)
+		.addFunction ("apply_gain_ramp", &DSP::apply_gain_ramp)
+		.addFunction ("mix_buffers_with_ramp", &DSP::mix_buffers_with_ramp)
 		.addFunction ("log_meter", &DSP::log_meter)
 		.addFunction ("log_meter_coeff", &DSP::log_meter_coeff)
 		.addFunction ("process_map", &DSP::process_map)
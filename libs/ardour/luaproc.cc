@@ -43,11 +43,18 @@
 using namespace ARDOUR;
 using namespace PBD;
 
+/* size of the realtime memory pool of each LuaProc */
+static const size_t mempool_size = 3145728;
+
+/* memory in use by a Lua DSP script above which garbage collection
+ * catches up regardless of the per-cycle budget, half of the pool */
+static const int gc_high_water_kb = mempool_size / 2048;
+
 LuaProc::LuaProc (AudioEngine& engine,
                   Session& session,
                   const std::string &script)
 	: Plugin (engine, session)
-	, _mempool ("LuaProc", 3145728)
+	, _mempool ("LuaProc", mempool_size)
 #ifdef USE_TLSF
 	, lua (lua_newstate (&PBD::TLSF::lalloc, &_mempool))
 #elif defined USE_MALLOC
@@ -80,7 +87,7 @@ LuaProc::LuaProc (AudioEngine& engine,
 
 LuaProc::LuaProc (const LuaProc &other)
 	: Plugin (other)
-	, _mempool ("LuaProc", 3145728)
+	, _mempool ("LuaProc", mempool_size)
 #ifdef USE_TLSF
 	, lua (lua_newstate (&PBD::TLSF::lalloc, &_mempool))
 #elif defined USE_MALLOC
@@ -625,6 +632,11 @@ LuaProc::configure_io (ChanCount in, ChanCount out)
 	_configured_in = in;
 	_configured_out = out;
 
+	/* from now on garbage is only collected in connect_and_run (),
+	 * incrementally with a fixed budget per cycle */
+	lua.collect_garbage ();
+	lua.manual_gc ();
+
 	return true;
 }
 
@@ -774,7 +786,11 @@ LuaProc::connect_and_run (BufferSet& bufs,
 	int64_t t1 = g_get_monotonic_time ();
 #endif
 
-	lua.collect_garbage_step ();
+	lua.collect_garbage_step (Config->get_lua_dsp_gc_budget ());
+	if (lua.gc_kbytes () > gc_high_water_kb) {
+		/* the script allocates faster than the budget reclaims */
+		lua.collect_garbage_step (gc_high_water_kb);
+	}
 #ifdef WITH_LUAPROC_STATS
 	if (++_stats_cnt > 0) {
 		int64_t t2 = g_get_monotonic_time ();
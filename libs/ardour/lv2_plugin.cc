@@ -25,7 +25,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <cctype>
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include <limits>
@@ -45,6 +48,7 @@
 #include "pbd/compose.h"
 #include "pbd/error.h"
 #include "pbd/locale_guard.h"
+#include "pbd/pathexpand.h"
 #include "pbd/pthread_utils.h"
 #include "pbd/replace_all.h"
 #include "pbd/xml++.h"
@@ -62,8 +66,10 @@
 #include "ardour/audioengine.h"
 #include "ardour/directory_names.h"
 #include "ardour/debug.h"
+#include "ardour/filesystem_paths.h"
 #include "ardour/lv2_plugin.h"
 #include "ardour/midi_patch_manager.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/session.h"
 #include "ardour/tempo.h"
 #include "ardour/types.h"
@@ -140,6 +146,21 @@ public:
 	~LV2World ();
 
 	void load_bundled_plugins(bool verbose=false);
+	void load_bundle(const std::string& bundle_uri);
+
+	const LilvPlugin* get_plugin(const char* plugin_uri);
+	void load_presets(const char* plugin_uri);
+
+	/** Bundles to load on demand, indexed by plugin URI.
+	 * Only used when the world was not loaded completely,
+	 * see LV2PluginInfo::discover.
+	 */
+	struct CatalogueEntry {
+		std::string              bundle;
+		std::vector<std::string> preset_bundles;
+	};
+
+	std::map<std::string, CatalogueEntry> catalogue;
 
 	LilvWorld* world;
 
@@ -218,6 +239,7 @@ public:
 
 private:
 	bool _bundle_checked;
+	std::set<std::string> _loaded_bundles;
 };
 
 static LV2World _world;
@@ -395,6 +417,7 @@ LV2Plugin::LV2Plugin (AudioEngine& engine,
 	, _patch_port_out_index((uint32_t)-1)
 	, _uri_map(URIMap::instance())
 	, _no_sample_accurate_ctrl (false)
+	, _inplace_broken (false)
 	, _connect_all_audio_outputs (false)
 {
 	init(c_plugin, rate);
@@ -414,6 +437,7 @@ LV2Plugin::LV2Plugin (const LV2Plugin& other)
 	, _patch_port_out_index((uint32_t)-1)
 	, _uri_map(URIMap::instance())
 	, _no_sample_accurate_ctrl (false)
+	, _inplace_broken (false)
 	, _connect_all_audio_outputs (false)
 {
 	init(other._impl->plugin, other._sample_rate);
@@ -656,14 +680,9 @@ LV2Plugin::init(const void* c_plugin, samplecnt_t rate)
 	}
 #endif
 
-	if (lilv_plugin_has_feature(plugin, _world.lv2_inPlaceBroken)) {
-		error << string_compose(
-		    _("LV2: \"%1\" cannot be used, since it cannot do inplace processing."),
-		    lilv_node_as_string(_impl->name)) << endmsg;
-		lilv_node_free(_impl->name);
-		lilv_node_free(_impl->author);
-		throw failed_constructor();
-	}
+	/* PluginInsert::check_inplace() connects inputs and outputs to
+	 * separate buffers for these */
+	_inplace_broken = lilv_plugin_has_feature(plugin, _world.lv2_inPlaceBroken);
 
 	LilvNodes* optional_features = lilv_plugin_get_optional_features (plugin);
 	if (lilv_nodes_contains (optional_features, _world.bufz_coarseBlockLength)) {
@@ -1510,6 +1529,8 @@ get_value(LilvWorld* world, const LilvNode* subject, const LilvNode* predicate)
 void
 LV2Plugin::find_presets()
 {
+	_world.load_presets(lilv_node_as_uri(lilv_plugin_get_uri(_impl->plugin)));
+
 	/* see also LV2PluginInfo::get_presets */
 	LilvNode* lv2_appliesTo = lilv_new_uri(_world.world, LV2_CORE__appliesTo);
 	LilvNode* pset_Preset   = lilv_new_uri(_world.world, LV2_PRESETS__Preset);
@@ -3212,10 +3233,11 @@ LV2Plugin::latency_compute_run()
 	// this is done in the main thread. non realtime.
 	const samplecnt_t bufsize = _engine.samples_per_cycle();
 	float*            buffer  = (float*) malloc(_engine.samples_per_cycle() * sizeof(float));
+	float*            out_buf = (float*) malloc(_engine.samples_per_cycle() * sizeof(float));
 
 	memset(buffer, 0, sizeof(float) * bufsize);
 
-	// FIXME: Ensure plugins can handle in-place processing
+	// outputs use a separate buffer, in case the plugin is inPlaceBroken
 
 	port_index = 0;
 
@@ -3225,7 +3247,7 @@ LV2Plugin::latency_compute_run()
 				lilv_instance_connect_port(_impl->instance, port_index, buffer);
 				in_index++;
 			} else if (parameter_is_output(port_index)) {
-				lilv_instance_connect_port(_impl->instance, port_index, buffer);
+				lilv_instance_connect_port(_impl->instance, port_index, out_buf);
 				out_index++;
 			}
 		}
@@ -3238,6 +3260,7 @@ LV2Plugin::latency_compute_run()
 		activate();
 	}
 	free(buffer);
+	free(out_buf);
 }
 
 const LilvPort*
@@ -3430,6 +3453,56 @@ LV2World::load_bundled_plugins(bool verbose)
 	}
 }
 
+/** Load a single bundle, unless all plugins have already been loaded. */
+void
+LV2World::load_bundle(const std::string& bundle_uri)
+{
+	if (_bundle_checked || bundle_uri.empty() || !_loaded_bundles.insert(bundle_uri).second) {
+		return;
+	}
+	DEBUG_TRACE(DEBUG::LV2, string_compose("loading LV2 bundle %1\n", bundle_uri));
+	LilvNode *node = lilv_new_uri(world, bundle_uri.c_str());
+	lilv_world_load_bundle(world, node);
+	lilv_node_free(node);
+}
+
+/** Look up a plugin, loading its bundle if necessary. */
+const LilvPlugin*
+LV2World::get_plugin(const char* plugin_uri)
+{
+	std::map<std::string, CatalogueEntry>::const_iterator c = catalogue.find(plugin_uri);
+	if (c != catalogue.end()) {
+		load_bundle(c->second.bundle);
+	}
+
+	LilvNode* uri = lilv_new_uri(world, plugin_uri);
+	if (!uri) {
+		return NULL;
+	}
+
+	const LilvPlugin* lp = lilv_plugins_get_by_uri(lilv_world_get_all_plugins(world), uri);
+	if (!lp && !_bundle_checked) {
+		/* not (or no longer) where the catalogue expects it */
+		load_bundled_plugins();
+		lp = lilv_plugins_get_by_uri(lilv_world_get_all_plugins(world), uri);
+	}
+	lilv_node_free(uri);
+	return lp;
+}
+
+/** Load all bundles which provide presets for the given plugin. */
+void
+LV2World::load_presets(const char* plugin_uri)
+{
+	std::map<std::string, CatalogueEntry>::const_iterator c = catalogue.find(plugin_uri);
+	if (c == catalogue.end()) {
+		return;
+	}
+	for (std::vector<std::string>::const_iterator i = c->second.preset_bundles.begin(); i != c->second.preset_bundles.end(); ++i) {
+		load_bundle(*i);
+	}
+}
+
 LV2PluginInfo::LV2PluginInfo (const char* plugin_uri)
 {
 	type = ARDOUR::LV2;
@@ -3447,13 +3520,9 @@ LV2PluginInfo::load(Session& session)
 {
 	try {
 		PluginPtr plugin;
-		const LilvPlugins* plugins = lilv_world_get_all_plugins(_world.world);
-		LilvNode* uri = lilv_new_uri(_world.world, _plugin_uri);
-		if (!uri) { throw failed_constructor(); }
-		const LilvPlugin* lp = lilv_plugins_get_by_uri(plugins, uri);
+		const LilvPlugin* lp = _world.get_plugin(_plugin_uri);
 		if (!lp) { throw failed_constructor(); }
 		plugin.reset(new LV2Plugin(session.engine(), session, lp, session.sample_rate()));
-		lilv_node_free(uri);
 		plugin->set_info(PluginInfoPtr(shared_from_this ()));
 		return plugin;
 	} catch (failed_constructor& err) {
@@ -3468,19 +3537,12 @@ LV2PluginInfo::get_presets (bool /*user_only*/) const
 {
 	std::vector<Plugin::PresetRecord> p;
 
-	const LilvPlugin* lp = NULL;
-	try {
-		PluginPtr plugin;
-		const LilvPlugins* plugins = lilv_world_get_all_plugins(_world.world);
-		LilvNode* uri = lilv_new_uri(_world.world, _plugin_uri);
-		if (!uri) { throw failed_constructor(); }
-		lp = lilv_plugins_get_by_uri(plugins, uri);
-		if (!lp) { throw failed_constructor(); }
-		lilv_node_free(uri);
-	} catch (failed_constructor& err) {
+	const LilvPlugin* lp = _world.get_plugin(_plugin_uri);
+	if (!lp) {
 		return p;
 	}
-	assert (lp);
+	_world.load_presets(_plugin_uri);
+
 	// see LV2Plugin::find_presets
 	LilvNode* lv2_appliesTo = lilv_new_uri(_world.world, LV2_CORE__appliesTo);
 	LilvNode* pset_Preset   = lilv_new_uri(_world.world, LV2_PRESETS__Preset);
@@ -3514,12 +3576,217 @@ LV2PluginInfo::get_presets (bool /*user_only*/) const
 	return p;
 }
 
+/* *** LV2 plugin catalogue *** */
+
+/* version 2: includes plugins with lv2:inPlaceBroken */
+static const int lv2_catalogue_version = 2;
+
+static std::string
+lv2_catalogue_path()
+{
+	return Glib::build_filename(user_cache_directory(), X_("lv2_catalogue"));
+}
+
+/** Summarize all bundles that lilv would load: their paths and the
+ * modification time of the bundle and of its top-level data files.
+ */
+static std::string
+lv2_bundle_fingerprint()
+{
+	PBD::Searchpath spath(lv2_bundled_search_path());
+
+	std::string lv2_path = Glib::getenv("LV2_PATH");
+	if (lv2_path.empty()) {
+		/* same as lilv's default LV2_PATH */
+#if defined PLATFORM_WINDOWS
+		spath.push_back(Glib::build_filename(Glib::getenv("APPDATA"), "LV2"));
+		spath.push_back(Glib::build_filename(Glib::getenv("COMMONPROGRAMFILES"), "LV2"));
+#elif defined __APPLE__
+		lv2_path = "~/.lv2:~/Library/Audio/Plug-Ins/LV2:/usr/local/lib/lv2:/usr/lib/lv2:/Library/Audio/Plug-Ins/LV2";
+#else
+		lv2_path = "~/.lv2:/usr/lib64/lv2:/usr/lib/lv2:/usr/local/lib64/lv2:/usr/local/lib/lv2";
+#endif
+	}
+	spath += PBD::Searchpath(PBD::search_path_expand(lv2_path));
+
+	vector<string> bundles;
+	find_paths_matching_filter(bundles, spath, lv2_filter, 0, true, true, false);
+	std::sort(bundles.begin(), bundles.end());
+
+	std::string fp;
+	for (vector<string>::const_iterator b = bundles.begin(); b != bundles.end(); ++b) {
+		GStatBuf sb;
+		if (g_stat(b->c_str(), &sb)) {
+			continue;
+		}
+		time_t mtime = sb.st_mtime;
+		try {
+			Glib::Dir dir(*b);
+			for (Glib::DirIterator di = dir.begin(); di != dir.end(); di++) {
+				const std::string fn = *di;
+				if (fn.length() > 4 && fn.find(".ttl") == fn.length() - 4
+				    && !g_stat(Glib::build_filename(*b, fn).c_str(), &sb)) {
+					mtime = std::max(mtime, (time_t) sb.st_mtime);
+				}
+			}
+		} catch (Glib::FileError const&) {
+			continue;
+		}
+		fp += string_compose("%1 %2\n", *b, (int64_t) mtime);
+	}
+
+	gchar* sum = g_compute_checksum_for_string(G_CHECKSUM_SHA1, fp.c_str(), -1);
+	std::string rv(sum);
+	g_free(sum);
+	return rv;
+}
+
+/** Remember the plugin's bundle and any bundle which provides presets for it,
+ * so that they can be loaded on demand.
+ */
+static XMLNode*
+lv2_catalogue_add(LV2World& world, const LilvPlugin* p, PluginInfoPtr info)
+{
+	LV2World::CatalogueEntry entry;
+	entry.bundle = lilv_node_as_uri(lilv_plugin_get_bundle_uri(p));
+
+	XMLNode* node = new XMLNode(X_("Plugin"));
+	node->set_property(X_("uri"), info->unique_id);
+	node->set_property(X_("bundle"), entry.bundle);
+	node->set_property(X_("name"), info->name);
+	node->set_property(X_("category"), info->category);
+	node->set_property(X_("creator"), info->creator);
+	node->set_property(X_("audio-in"), info->n_inputs.n_audio());
+	node->set_property(X_("midi-in"), info->n_inputs.n_midi());
+	node->set_property(X_("audio-out"), info->n_outputs.n_audio());
+	node->set_property(X_("midi-out"), info->n_outputs.n_midi());
+
+	/* presets may live in other bundles (e.g. user presets),
+	 * use the directory of the file describing them.
+	 */
+	LilvNode*  pset_Preset  = lilv_new_uri(world.world, LV2_PRESETS__Preset);
+	LilvNode*  rdfs_seeAlso = lilv_new_uri(world.world, LILV_NS_RDFS "seeAlso");
+	LilvNodes* presets      = lilv_plugin_get_related(p, pset_Preset);
+	std::set<std::string> seen;
+	LILV_FOREACH(nodes, i, presets) {
+		LilvNodes* files = lilv_world_find_nodes(world.world, lilv_nodes_get(presets, i), rdfs_seeAlso, NULL);
+		LILV_FOREACH(nodes, f, files) {
+			const LilvNode* file = lilv_nodes_get(files, f);
+			if (!lilv_node_is_uri(file)) {
+				continue;
+			}
+			std::string bundle(lilv_node_as_uri(file));
+			bundle = bundle.substr(0, bundle.rfind('/') + 1);
+			if (bundle != entry.bundle && seen.insert(bundle).second) {
+				entry.preset_bundles.push_back(bundle);
+				XMLNode* child = new XMLNode(X_("Presets"));
+				child->set_property(X_("bundle"), bundle);
+				node->add_child_nocopy(*child);
+			}
+		}
+		lilv_nodes_free(files);
+	}
+	lilv_nodes_free(presets);
+	lilv_node_free(rdfs_seeAlso);
+	lilv_node_free(pset_Preset);
+
+	_world.catalogue[info->unique_id] = entry;
+	return node;
+}
+
+/** @return plugins listed in the catalogue, or NULL if it is missing or outdated */
+static PluginInfoList*
+lv2_catalogue_load(const std::string& fingerprint)
+{
+	const std::string path = lv2_catalogue_path();
+	if (!Glib::file_test(path, Glib::FILE_TEST_EXISTS)) {
+		return NULL;
+	}
+
+	XMLTree tree;
+	if (!tree.read(path)) {
+		warning << string_compose(_("Cannot parse LV2 plugin catalogue %1"), path) << endmsg;
+		return NULL;
+	}
+
+	int         version;
+	std::string fp;
+	XMLNode*    root = tree.root();
+	if (!root->get_property(X_("version"), version) || version != lv2_catalogue_version
+	    || !root->get_property(X_("fingerprint"), fp) || fp != fingerprint) {
+		return NULL;
+	}
+
+	PluginInfoList* plugs = new PluginInfoList;
+
+	for (XMLNodeConstIterator i = root->children().begin(); i != root->children().end(); ++i) {
+		std::string uri;
+		LV2World::CatalogueEntry entry;
+		uint32_t ai, mi, ao, mo;
+		if (!(*i)->get_property(X_("uri"), uri) || !(*i)->get_property(X_("bundle"), entry.bundle)
+		    || !(*i)->get_property(X_("audio-in"), ai) || !(*i)->get_property(X_("midi-in"), mi)
+		    || !(*i)->get_property(X_("audio-out"), ao) || !(*i)->get_property(X_("midi-out"), mo)) {
+			continue;
+		}
+
+		LV2PluginInfoPtr info(new LV2PluginInfo(uri.c_str()));
+		(*i)->get_property(X_("name"), info->name);
+		(*i)->get_property(X_("category"), info->category);
+		(*i)->get_property(X_("creator"), info->creator);
+		info->path      = "/NOPATH"; // Meaningless for LV2
+		info->unique_id = uri;
+		info->index     = 0; // Meaningless for LV2
+		info->n_inputs.set_audio(ai);
+		info->n_inputs.set_midi(mi);
+		info->n_outputs.set_audio(ao);
+		info->n_outputs.set_midi(mo);
+
+		for (XMLNodeConstIterator c = (*i)->children().begin(); c != (*i)->children().end(); ++c) {
+			std::string bundle;
+			if ((*c)->get_property(X_("bundle"), bundle)) {
+				entry.preset_bundles.push_back(bundle);
+			}
+		}
+
+		_world.catalogue[uri] = entry;
+		plugs->push_back(info);
+	}
+
+	DEBUG_TRACE(DEBUG::LV2, string_compose("loaded %1 plugins from catalogue %2\n", plugs->size(), path));
+	return plugs;
+}
+
 PluginInfoList*
 LV2PluginInfo::discover()
 {
+	/* With a catalogue, plugins are listed without loading any bundle;
+	 * a plugin's bundle is only loaded when it is instantiated, and
+	 * bundles providing presets for it when presets are requested.
+	 */
+	const bool  use_catalogue = Config->get_lv2_plugin_catalogue();
+	std::string fingerprint;
+
+	if (use_catalogue) {
+		fingerprint = lv2_bundle_fingerprint();
+		_world.catalogue.clear();
+		PluginInfoList* plugs = lv2_catalogue_load(fingerprint);
+		if (plugs) {
+			return plugs;
+		}
+	}
+
 	LV2World world;
 	world.load_bundled_plugins();
-	_world.load_bundled_plugins(true);
+	if (!use_catalogue) {
+		_world.load_bundled_plugins(true);
+	}
+
+	XMLNode* catalogue = 0;
+	if (use_catalogue) {
+		catalogue = new XMLNode(X_("LV2Catalogue"));
+		catalogue->set_property(X_("version"), lv2_catalogue_version);
+		catalogue->set_property(X_("fingerprint"), fingerprint);
+	}
 
 	PluginInfoList*    plugs   = new PluginInfoList;
 	const LilvPlugins* plugins = lilv_world_get_all_plugins(world.world);
@@ -3538,14 +3805,6 @@ LV2PluginInfo::discover()
 			continue;
 		}
 
-		if (lilv_plugin_has_feature(p, world.lv2_inPlaceBroken)) {
-			warning << string_compose(
-			    _("Ignoring LV2 plugin \"%1\" since it cannot do inplace processing."),
-			    lilv_node_as_string(name)) << endmsg;
-			lilv_node_free(name);
-			continue;
-		}
-
 		int err = 0;
 		LilvNodes* required_features = lilv_plugin_get_required_features (p);
 		LILV_FOREACH(nodes, i, required_features) {
@@ -3671,8 +3930,20 @@ LV2PluginInfo::discover()
 		info->unique_id = lilv_node_as_uri(lilv_plugin_get_uri(p));
 		info->index     = 0; // Meaningless for LV2
 
+		if (catalogue) {
+			catalogue->add_child_nocopy(*lv2_catalogue_add(world, p, info));
+		}
+
 		plugs->push_back(info);
 	}
 
+	if (catalogue) {
+		XMLTree tree;
+		tree.set_root(catalogue);
+		if (!tree.write(lv2_catalogue_path())) {
+			error << string_compose(_("Could not save LV2 plugin catalogue to %1"), lv2_catalogue_path()) << endmsg;
+		}
+	}
+
 	return plugs;
 }
@@ -55,6 +55,11 @@ PeakMeter::PeakMeter (Session& s, const std::string& name)
 	_reset_max      = 1;
 	_bufcnt         = 0;
 	_combined_peak  = 0;
+	_levels         = new std::vector<Levels>;
+	_levels_count   = 0;
+	_levels_type    = MeterPeak;
+	_levels_serial  = 0;
+	_reset_dsp_hold = 0;
 }
 
 PeakMeter::~PeakMeter ()
@@ -74,6 +79,10 @@ PeakMeter::~PeakMeter ()
 		_peak_power.pop_back ();
 		_max_peak_signal.pop_back ();
 	}
+	delete &levels ();
+	for (size_t i = 0; i < _superseded_levels.size (); ++i) {
+		delete _superseded_levels[i];
+	}
 }
 
 std::string
@@ -100,6 +109,16 @@ PeakMeter::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos_t /*end
 	/* max-peak is set from DPM's peak-buffer, so DPM also needs to be reset in sync */
 	const bool reset_dpm = g_atomic_int_compare_and_exchange (&_reset_dpm, 1, 0) || reset_max;
 
+	/* a client consumed the published levels, restart the DSP meters' hold */
+	if (g_atomic_int_compare_and_exchange (&_reset_dsp_hold, 1, 0)) {
+		for (size_t i = 0; i < _kmeter.size (); ++i) {
+			_kmeter[i]->read ();
+			_iec1meter[i]->read ();
+			_iec2meter[i]->read ();
+			_vumeter[i]->read ();
+		}
+	}
+
 	_combined_peak = 0;
 
 	const uint32_t n_audio = min (current_meters.n_audio (), bufs.count ().n_audio ());
@@ -205,6 +224,10 @@ PeakMeter::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos_t /*end
 		_combined_peak = 0;
 	}
 
+	if (_bufcnt > zoh || reset_dpm) {
+		publish_levels ();
+	}
+
 	if (_bufcnt > zoh) {
 		_bufcnt = 0;
 	}
@@ -306,6 +329,21 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 		_max_peak_signal.pop_back ();
 	}
 
+	/* grow the snapshot without invalidating a concurrent read_levels () */
+	if (levels ().size () < limit) {
+		std::vector<Levels>* l = new std::vector<Levels> (levels ());
+		l->resize (limit);
+		const bool published = g_atomic_int_get (&_levels_serial) != 0;
+		if (published) {
+			g_atomic_int_inc (&_levels_serial); // odd: update in progress
+		}
+		_superseded_levels.push_back (&levels ());
+		g_atomic_pointer_set (&_levels, l);
+		if (published) {
+			g_atomic_int_inc (&_levels_serial); // even: consistent
+		}
+	}
+
 	while (_peak_power.size () < limit) {
 		_peak_buffer.push_back (0);
 		if (_peak_power.size () < current_meters.n_midi ()) {
@@ -353,6 +391,25 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 
 #define CHECKSIZE(MTR) (n < MTR.size () + n_midi && n >= n_midi)
 
+/* meter-types that share a DSP meter instance */
+static int
+dsp_meter_group (int t)
+{
+	if (t & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
+		return MeterKrms | MeterK20 | MeterK14 | MeterK12;
+	}
+	if (t & (MeterIEC1DIN | MeterIEC1NOR)) {
+		return MeterIEC1DIN | MeterIEC1NOR;
+	}
+	if (t & (MeterIEC2BBC | MeterIEC2EBU)) {
+		return MeterIEC2BBC | MeterIEC2EBU;
+	}
+	if (t & MeterVU) {
+		return MeterVU;
+	}
+	return 0;
+}
+
 float
 PeakMeter::meter_level (uint32_t n, MeterType type)
 {
@@ -364,6 +421,19 @@ PeakMeter::meter_level (uint32_t n, MeterType type)
 		}
 	}
 
+	/* the DSP meters of the current type are read by publish_levels();
+	 * report the published value for those. */
+	const int group = dsp_meter_group (type);
+	if (group != 0 && group == dsp_meter_group (_meter_type)) {
+		std::vector<Levels> const& lv (levels ());
+		const uint32_t n_midi = current_meters.n_midi ();
+		g_atomic_int_set (&_reset_dsp_hold, 1);
+		if (n >= n_midi && n < lv.size ()) {
+			return lv[n].level;
+		}
+		return minus_infinity ();
+	}
+
 	float mcptmp;
 	switch (type) {
 		case MeterKrms:
@@ -425,6 +495,89 @@ PeakMeter::meter_level (uint32_t n, MeterType type)
 	return minus_infinity ();
 }
 
+/** Publish the current levels for read_levels ()
+ * (runs in realtime context, at most once per ~20ms)
+ */
+void
+PeakMeter::publish_levels ()
+{
+	std::vector<Levels>& lv (levels ());
+
+	const uint32_t n_midi  = current_meters.n_midi ();
+	const uint32_t n_total = min (current_meters.n_total (), (uint32_t)lv.size ());
+
+	g_atomic_int_inc (&_levels_serial); // odd: update in progress
+
+	uint32_t n = 0;
+
+	for (; n < n_midi && n < n_total; ++n) {
+		lv[n].peak     = _peak_power[n];
+		lv[n].max_peak = minus_infinity ();
+		lv[n].level    = _peak_power[n];
+	}
+
+	for (uint32_t i = 0; n < n_total; ++i, ++n) {
+		Levels& l (lv[n]);
+		l.peak     = _peak_power[n];
+		l.max_peak = accurate_coefficient_to_dB (_max_peak_signal[n]);
+
+		switch (dsp_meter_group (_meter_type)) {
+			case MeterKrms | MeterK20 | MeterK14 | MeterK12:
+				l.level = accurate_coefficient_to_dB (_kmeter[i]->peek ());
+				break;
+			case MeterIEC1DIN | MeterIEC1NOR:
+				l.level = accurate_coefficient_to_dB (_iec1meter[i]->peek ());
+				break;
+			case MeterIEC2BBC | MeterIEC2EBU:
+				l.level = accurate_coefficient_to_dB (_iec2meter[i]->peek ());
+				break;
+			case MeterVU:
+				l.level = accurate_coefficient_to_dB (_vumeter[i]->peek ());
+				break;
+			default:
+				l.level = (_meter_type == MeterMaxPeak) ? l.max_peak : l.peak;
+				break;
+		}
+	}
+
+	_levels_count = n_total;
+	_levels_type  = _meter_type;
+
+	g_atomic_int_inc (&_levels_serial); // even: consistent
+}
+
+bool
+PeakMeter::read_levels (std::vector<Levels>& rv, MeterType& type) const
+{
+	if ((!_active && !_pending_active) || g_atomic_int_get (&_reset_max)) {
+		return false;
+	}
+
+	for (int retry = 0; retry < 4; ++retry) {
+		const gint serial = g_atomic_int_get (&_levels_serial);
+		if (serial == 0) {
+			/* nothing published yet */
+			return false;
+		}
+		if (serial & 1) {
+			continue;
+		}
+
+		std::vector<Levels> const& lv (levels ());
+		const uint32_t n = min (_levels_count, (uint32_t)lv.size ());
+		rv.resize (n);
+		std::copy (lv.begin (), lv.begin () + n, rv.begin ());
+		type = _levels_type;
+
+		if (g_atomic_int_get (&_levels_serial) == serial) {
+			/* the DSP meters' hold may now be restarted */
+			g_atomic_int_set (&_reset_dsp_hold, 1);
+			return true;
+		}
+	}
+	return false;
+}
+
 void
 PeakMeter::set_meter_type (MeterType t)
 {
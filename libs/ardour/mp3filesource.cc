@@ -54,9 +54,19 @@ Mp3FileSource::close ()
 {
 }
 
+std::string
+Mp3FileSource::decoded_cache_id () const
+{
+	return string_compose ("%1%%%2", _path, _channel);
+}
+
 samplecnt_t
 Mp3FileSource::read_unlocked (Sample* dst, samplepos_t start, samplecnt_t cnt) const
 {
+	samplecnt_t n;
+	if ((n = read_decoded (dst, start, cnt)) >= 0) {
+		return n;
+	}
 	return _mp3.read_unlocked (dst, start, cnt, _channel);
 }
 
@@ -57,6 +57,7 @@
 #include "ardour/midi_state_tracker.h"
 #include "ardour/plugin.h"
 #include "ardour/plugin_manager.h"
+#include "ardour/plugin_pool.h"
 #include "ardour/port.h"
 #include "ardour/session.h"
 #include "ardour/types.h"
@@ -220,7 +221,7 @@ ARDOUR::find_plugin(Session& session, string identifier, PluginType type)
 
 	for (i = plugs.begin(); i != plugs.end(); ++i) {
 		if (identifier == (*i)->unique_id){
-			return (*i)->load (session);
+			return session.plugin_pool ().load (*i);
 		}
 	}
 
@@ -232,7 +233,7 @@ ARDOUR::find_plugin(Session& session, string identifier, PluginType type)
 
 	for (i = plugs.begin(); i != plugs.end(); ++i) {
 		if (identifier == (*i)->name){
-			return (*i)->load (session);
+			return session.plugin_pool ().load (*i);
 		}
 	}
 #endif
@@ -245,7 +246,7 @@ ARDOUR::find_plugin(Session& session, string identifier, PluginType type)
 
 	for (i = plugs.begin(); i != plugs.end(); ++i) {
 		if (identifier == (*i)->name){
-			return (*i)->load (session);
+			return session.plugin_pool ().load (*i);
 		}
 	}
 #endif
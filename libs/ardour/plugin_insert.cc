@@ -26,6 +26,7 @@
 #include "libardour-config.h"
 #endif
 
+#include <algorithm>
 #include <string>
 
 #include "pbd/failed_constructor.h"
@@ -35,13 +36,18 @@
 #include "ardour/audio_buffer.h"
 #include "ardour/automation_list.h"
 #include "ardour/buffer_set.h"
+#include "ardour/dB.h"
 #include "ardour/debug.h"
 #include "ardour/event_type_map.h"
+#include "ardour/graph.h"
 #include "ardour/ladspa_plugin.h"
 #include "ardour/luaproc.h"
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
+#include "ardour/plugin_pool.h"
 #include "ardour/port.h"
+#include "ardour/runtime_functions.h"
+#include "ardour/slavable_automation_control.h"
 
 #ifdef LV2_SUPPORT
 #include "ardour/lv2_plugin.h"
@@ -72,6 +78,11 @@ using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
 
+/* automation events per cycle which are handled in a batch, see
+ * PluginInsert::collect_automation_events()
+ */
+static const size_t max_automation_events = 512;
+
 const string PluginInsert::port_automation_node_name = "PortAutomation";
 
 PluginInsert::PluginInsert (Session& s, boost::shared_ptr<Plugin> plug)
@@ -83,14 +94,25 @@ PluginInsert::PluginInsert (Session& s, boost::shared_ptr<Plugin> plug)
 	, _signal_analysis_collect_nsamples_max (0)
 	, _configured (false)
 	, _no_inplace (false)
+	, _alias_inputs (false)
+	, _parallel_ok (false)
 	, _strict_io (false)
 	, _custom_cfg (false)
 	, _maps_from_state (false)
 	, _latency_changed (false)
+	, _automation_events_stale (0)
 	, _bypass_port (UINT32_MAX)
 	, _inverted_bypass_enable (false)
 	, _stat_reset (0)
+	, _silence_skippable (false)
+	, _silent_tail (-1)
+	, _silent_samples (0)
+	, _skipping_silence (false)
+	, _silent_input_hint (false)
+	, _silence_wake (0)
 {
+	_automation_events.reserve (max_automation_events);
+
 	/* the first is the master */
 
 	if (plug) {
@@ -284,6 +306,14 @@ PluginInsert::control_list_automation_state_changed (Evoral::Parameter which, Au
 	}
 }
 
+void
+PluginInsert::automation_list_automation_state_changed (Evoral::Parameter param, AutoState as)
+{
+	Automatable::automation_list_automation_state_changed (param, as);
+	/* the set of controls playing back automation changed */
+	g_atomic_int_set (&_automation_events_stale, 1);
+}
+
 ChanCount
 PluginInsert::output_streams() const
 {
@@ -844,6 +874,7 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 {
 	if (_mapping_changed) { // ToDo use a counter, increment until match
 		_no_inplace = check_inplace ();
+		_parallel_ok = check_parallel ();
 		_mapping_changed = false;
 	}
 	// TODO: atomically copy maps & _no_inplace
@@ -982,6 +1013,16 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 			}
 		}
 
+		const uint32_t n_audio_in = natural_input_streams ().n_audio ();
+
+		if (_alias_inputs) {
+			/* outputs are written to inplace_bufs, so the plugin may read
+			 * its inputs from the route's buffers without copying them */
+			for (uint32_t out = 0; out < _configured_out.n_audio (); ++out) {
+				_mapped_bufs.set_mirror_buffer (DataType::AUDIO, n_audio_in + out, inplace_bufs.get_available (DataType::AUDIO, n_audio_in + out));
+			}
+		}
+
 		pc = 0;
 		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
 
@@ -989,18 +1030,27 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 			ARDOUR::ChanMapping i_out_map (out_map.p(pc));
 			ARDOUR::ChanCount mapped;
 
-			/* map inputs sequentially */
-			for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
-				for (uint32_t in = 0; in < natural_input_streams().get (*t); ++in) {
+			if (_alias_inputs) {
+				BufferSet& silent_bufs = _session.get_silent_buffers (ChanCount (DataType::AUDIO, 1));
+				for (uint32_t in = 0; in < n_audio_in; ++in) {
 					bool valid;
-					uint32_t in_idx = in_map.p(pc).get (*t, in, &valid);
-					uint32_t m = mapped.get (*t);
-					if (valid) {
-						inplace_bufs.get_available (*t, m).read_from (bufs.get_available (*t, in_idx), nframes, offset, offset);
-					} else {
-						inplace_bufs.get_available (*t, m).silence (nframes, offset);
+					uint32_t in_idx = in_map.p(pc).get (DataType::AUDIO, in, &valid);
+					_mapped_bufs.set_mirror_buffer (DataType::AUDIO, in, valid ? bufs.get_available (DataType::AUDIO, in_idx) : silent_bufs.get_available (DataType::AUDIO, 0));
+				}
+			} else {
+				/* map inputs sequentially */
+				for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+					for (uint32_t in = 0; in < natural_input_streams().get (*t); ++in) {
+						bool valid;
+						uint32_t in_idx = in_map.p(pc).get (*t, in, &valid);
+						uint32_t m = mapped.get (*t);
+						if (valid) {
+							inplace_bufs.get_available (*t, m).read_from (bufs.get_available (*t, in_idx), nframes, offset, offset);
+						} else {
+							inplace_bufs.get_available (*t, m).silence (nframes, offset);
+						}
+						mapped.set (*t, m + 1);
 					}
-					mapped.set (*t, m + 1);
 				}
 			}
 
@@ -1009,7 +1059,7 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 				i_out_map.offset_to (*t, natural_input_streams ().get (*t));
 			}
 
-			if ((*i)->connect_and_run (inplace_bufs, start, end, speed, i_in_map, i_out_map, nframes, offset)) {
+			if ((*i)->connect_and_run (_alias_inputs ? _mapped_bufs : inplace_bufs, start, end, speed, i_in_map, i_out_map, nframes, offset)) {
 				deactivate ();
 			}
 		}
@@ -1037,10 +1087,35 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 		}
 	} else {
 		/* in-place processing */
-		uint32_t pc = 0;
-		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
-			if ((*i)->connect_and_run(bufs, start, end, speed, in_map.p(pc), out_map.p(pc), nframes, offset)) {
-				deactivate ();
+		Graph* graph = _parallel_ok ? _session.process_graph () : 0;
+
+		if (graph && Config->get_parallel_replicated_plugins () && _replica_tasks.size () == _plugins.size ()) {
+			/* replicated instances use disjoint buffers (see check_parallel),
+			 * run them concurrently on idle process threads */
+			for (uint32_t pc = 0; pc < _replica_tasks.size (); ++pc) {
+				ReplicaTask& t (_replica_tasks[pc]);
+				t.bufs    = &bufs;
+				t.in_map  = &in_map.p (pc);
+				t.out_map = &out_map.p (pc);
+				t.start   = start;
+				t.end     = end;
+				t.speed   = speed;
+				t.nframes = nframes;
+				t.offset  = offset;
+				t.ret     = 0;
+			}
+			graph->run_tasks (&_replica_task_ptrs[0], _replica_task_ptrs.size ());
+			for (uint32_t pc = 0; pc < _replica_tasks.size (); ++pc) {
+				if (_replica_tasks[pc].ret) {
+					deactivate ();
+				}
+			}
+		} else {
+			uint32_t pc = 0;
+			for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
+				if ((*i)->connect_and_run(bufs, start, end, speed, in_map.p(pc), out_map.p(pc), nframes, offset)) {
+					deactivate ();
+				}
 			}
 		}
 		// now silence unconnected outputs
@@ -1203,8 +1278,16 @@ PluginInsert::silence (samplecnt_t nframes, samplepos_t start_sample)
 	_delaybuffers.flush ();
 
 	const ChanMapping in_map (natural_input_streams ());
-	const ChanMapping out_map (natural_output_streams ());
+	ChanMapping out_map (natural_output_streams ());
 	ChanCount maxbuf = ChanCount::max (natural_input_streams (), natural_output_streams());
+
+	if (_plugins.front ()->inplace_broken ()) {
+		/* outputs are mapped after the inputs, see _required_buffers */
+		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+			out_map.offset_to (*t, natural_input_streams ().get (*t));
+		}
+		maxbuf = natural_input_streams () + natural_output_streams ();
+	}
 #ifdef MIXBUS
 	if (is_channelstrip ()) {
 		if (_configured_in.n_audio() > 0) {
@@ -1231,6 +1314,30 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 	}
 
 	if (_pending_active) {
+		/* effects whose input has been silent for longer than their
+		 * latency and tail, and whose output is silent, are not run
+		 * until there is signal, MIDI data or automation again.
+		 */
+		const bool may_skip = _silence_skippable
+			&& Config->get_skip_silent_plugins ()
+			&& !g_atomic_int_compare_and_exchange (&_silence_wake, 1, 0)
+			&& !automation_playback ()
+			&& silent_input (bufs, nframes);
+
+		_silent_input_hint = false;
+
+		if (may_skip && _skipping_silence) {
+			/* pass on the silent input */
+			bypass (bufs, nframes);
+			_active = _pending_active;
+			return;
+		}
+
+		if (_skipping_silence) {
+			DEBUG_TRACE (DEBUG::Processors, string_compose ("%1 resumes after %2 silent samples\n", name (), _silent_samples));
+			_skipping_silence = false;
+		}
+
 #if defined MIXBUS && defined NDEBUG
 		if (!is_channelstrip ()) {
 			_timing_stats.start ();
@@ -1254,7 +1361,17 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 		_timing_stats.update ();
 #endif
 
+		if (may_skip && silent_output (bufs, nframes)) {
+			_silent_samples += nframes;
+			_skipping_silence = _silent_samples > effective_latency () + silence_tail ();
+		} else {
+			_silent_samples = 0;
+		}
+
 	} else {
+		_silent_samples    = 0;
+		_skipping_silence  = false;
+		_silent_input_hint = false;
 		_timing_stats.reset ();
 		// XXX should call ::silence() to run plugin(s) for consistent load.
 		// We'll need to change this anyway when bypass can be automated
@@ -1270,6 +1387,113 @@ PluginInsert::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sa
 	 */
 }
 
+bool
+PluginInsert::silent_input (BufferSet& bufs, pframes_t nframes) const
+{
+	/* all inputs including side-chain */
+	const ChanCount in (ChanCount::min (bufs.count (), _configured_internal));
+
+	for (uint32_t i = 0; i < in.n_midi (); ++i) {
+		if (!bufs.get_midi (i).empty ()) {
+			return false;
+		}
+	}
+	if (_silent_input_hint && !_sidechain) {
+		/* see Route::process_output_buffers */
+		return true;
+	}
+	for (uint32_t i = 0; i < in.n_audio (); ++i) {
+		if (compute_peak (bufs.get_audio (i).data (), nframes, 0) > GAIN_COEFF_SMALL) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool
+PluginInsert::silent_output (BufferSet& bufs, pframes_t nframes) const
+{
+	const uint32_t n_out = min (bufs.count ().n_audio (), _configured_out.n_audio ());
+
+	for (uint32_t i = 0; i < n_out; ++i) {
+		if (compute_peak (bufs.get_audio (i).data (), nframes, 0) > GAIN_COEFF_SMALL) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/** @return true if any parameter currently follows automation */
+bool
+PluginInsert::automation_playback () const
+{
+	if (!_session.transport_rolling () && !_session.bounce_processing ()) {
+		return false;
+	}
+
+	boost::shared_ptr<ControlList> cl = _automated_controls.reader ();
+	for (ControlList::const_iterator ci = cl->begin(); ci != cl->end(); ++ci) {
+		boost::shared_ptr<const Evoral::ControlList> clist ((*ci)->list ());
+		if (clist && (static_cast<AutomationList const&> (*clist)).automation_playback ()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/** @return samples of silent output after which the plugin is skipped, in addition to its latency */
+samplecnt_t
+PluginInsert::silence_tail () const
+{
+	if (_silent_tail >= 0) {
+		return _silent_tail;
+	}
+	return (samplecnt_t) Config->get_silent_plugin_hold () * _session.nominal_sample_rate () / 1000;
+}
+
+/** Collect the times of all automation events in (start, end) of the
+ * controls which are currently playing back automation. This replaces
+ * a find_next_event() call, which looks at every control, per split.
+ *
+ * @return false if the events cannot be handled in a batch
+ */
+bool
+PluginInsert::collect_automation_events (double start, double end)
+{
+	g_atomic_int_set (&_automation_events_stale, 0);
+	_automation_events.clear ();
+
+	boost::shared_ptr<ControlList> cl = _automated_controls.reader ();
+	for (ControlList::const_iterator ci = cl->begin(); ci != cl->end(); ++ci) {
+		if (!(*ci)->automation_playback ()) {
+			continue;
+		}
+		if (boost::dynamic_pointer_cast<SlavableAutomationControl> (*ci)) {
+			/* events of master controls are not included */
+			return false;
+		}
+
+		boost::shared_ptr<const Evoral::ControlList> alist ((*ci)->list ());
+		if (!alist) {
+			continue;
+		}
+
+		Evoral::ControlEvent cp (start, 0.0f);
+		Evoral::ControlList::const_iterator i = upper_bound (alist->begin(), alist->end(), &cp, Evoral::ControlList::time_comparator);
+
+		for (; i != alist->end() && (*i)->when < end; ++i) {
+			if (_automation_events.size () == _automation_events.capacity ()) {
+				/* do not allocate */
+				return false;
+			}
+			_automation_events.push_back ((*i)->when);
+		}
+	}
+
+	sort (_automation_events.begin (), _automation_events.end ());
+	return true;
+}
+
 void
 PluginInsert::automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes)
 {
@@ -1294,9 +1518,25 @@ PluginInsert::automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t
 		return;
 	}
 
+	/* Events of a forward cycle which does not wrap around the loop are
+	 * collected once, and again when the automation state of a control
+	 * changes meanwhile. Blocks between events are not shorter than
+	 * "automation-split-min" samples, unless the loop end forces a split.
+	 * The default of 1 splits at every event; larger values trade timing
+	 * accuracy (events are applied up to that many samples late) for
+	 * fewer plugin runs.
+	 */
+	bool              batch     = start < end && (!_loop_location || end <= _loop_location->end ()) && collect_automation_events (start, end);
+	const samplecnt_t min_split = max ((samplecnt_t) 1, (samplecnt_t) Config->get_automation_split_min ());
+	size_t            ev        = 0;
+
 	while (nframes) {
 
 		samplecnt_t cnt = min ((samplecnt_t) ceil (fabs (next_event.when - start)), (samplecnt_t) nframes);
+		cnt = max (cnt, min (min_split, (samplecnt_t) nframes));
+		if (_loop_location && start < end && start < _loop_location->end ()) {
+			cnt = min (cnt, _loop_location->end () - start);
+		}
 		assert (cnt > 0);
 
 		connect_and_run (bufs, start, start + cnt * speed, speed, cnt, offset, true);
@@ -1305,6 +1545,23 @@ PluginInsert::automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t
 		offset += cnt;
 		start += cnt * speed;
 
+		if (batch && g_atomic_int_get (&_automation_events_stale)) {
+			/* automation state changed during the cycle, e.g. touch */
+			batch = collect_automation_events (start, end);
+			ev    = 0;
+		}
+
+		if (batch) {
+			while (ev < _automation_events.size () && _automation_events[ev] <= start) {
+				++ev;
+			}
+			if (ev == _automation_events.size ()) {
+				break;
+			}
+			next_event.when = _automation_events[ev];
+			continue;
+		}
+
 		map_loop_range (start, end);
 
 		if (!find_next_event (start, end, next_event)) {
@@ -1593,6 +1850,58 @@ PluginInsert::is_channelstrip () const
 	return false;
 }
 
+/** @return true if replicated plugin instances can be run concurrently:
+ * in-place audio-only processing, where no two instances share a buffer.
+ */
+bool
+PluginInsert::check_parallel () const
+{
+	if (_match.method != Replicate || _no_inplace || get_count () < 2) {
+		return false;
+	}
+	if (_configured_internal.n_midi () > 0 || natural_input_streams ().n_midi () > 0 || natural_output_streams ().n_midi () > 0) {
+		return false;
+	}
+
+	uint64_t used = 0;
+
+	for (uint32_t pc = 0; pc < get_count (); ++pc) {
+		uint64_t mine = 0;
+
+		for (uint32_t i = 0; i < natural_input_streams ().n_audio (); ++i) {
+			bool valid;
+			uint32_t idx = _in_map.p (pc).get (DataType::AUDIO, i, &valid);
+			if (valid) {
+				if (idx >= 64) {
+					return false;
+				}
+				mine |= (uint64_t) 1 << idx;
+			}
+		}
+		for (uint32_t o = 0; o < natural_output_streams ().n_audio (); ++o) {
+			bool valid;
+			uint32_t idx = _out_map.p (pc).get (DataType::AUDIO, o, &valid);
+			if (valid) {
+				if (idx >= 64) {
+					return false;
+				}
+				mine |= (uint64_t) 1 << idx;
+			}
+		}
+		if (used & mine) {
+			return false;
+		}
+		used |= mine;
+	}
+	return true;
+}
+
+void
+PluginInsert::ReplicaTask::run ()
+{
+	ret = plugin->connect_and_run (*bufs, start, end, speed, *in_map, *out_map, nframes, offset);
+}
+
 bool
 PluginInsert::check_inplace ()
 {
@@ -2044,8 +2353,43 @@ PluginInsert::configure_io (ChanCount in, ChanCount out)
 	}
 
 	_no_inplace = check_inplace ();
+	_parallel_ok = check_parallel ();
 	_mapping_changed = false;
 
+	/* MIDI buffers are translated per BufferSet (LV2 event buffers,
+	 * VST events), so only audio-only plugins can use a mirror. Only
+	 * the LADSPA and LV2 specifications forbid writing to input ports;
+	 * Lua DSP scripts commonly process their buffers in place. */
+	switch (type ()) {
+	case ARDOUR::LADSPA:
+	case ARDOUR::LV2:
+		_alias_inputs = natural_input_streams ().n_midi () == 0 && natural_output_streams ().n_midi () == 0;
+		break;
+	default:
+		_alias_inputs = false;
+		break;
+	}
+	if (_alias_inputs) {
+		_mapped_bufs.attach_buffers (ChanCount (DataType::AUDIO, natural_input_streams ().n_audio () + _configured_out.n_audio ()));
+	}
+
+	/* instruments and plugins which may produce MIDI are always run */
+	_silence_skippable = !is_instrument () && natural_input_streams ().n_audio () > 0 && natural_output_streams ().n_midi () == 0;
+	_silent_tail       = _plugins.front ()->signal_tail ();
+	_silent_samples    = 0;
+	_skipping_silence  = false;
+
+	/* one task per replicated instance, used when _parallel_ok */
+	_replica_tasks.clear ();
+	_replica_task_ptrs.clear ();
+	if (_match.method == Replicate) {
+		_replica_tasks.resize (_plugins.size ());
+		for (uint32_t pc = 0; pc < _plugins.size (); ++pc) {
+			_replica_tasks[pc].plugin = _plugins[pc];
+			_replica_task_ptrs.push_back (&_replica_tasks[pc]);
+		}
+	}
+
 	/* only the "noinplace_buffers" thread buffers need to be this large,
 	 * this can be optimized. other buffers are fine with
 	 * ChanCount::max (natural_input_streams (), natural_output_streams())
@@ -2704,7 +3048,8 @@ PluginInsert::set_state(const XMLNode& node, int version)
 
 	if (_plugins.size() != count) {
 		for (uint32_t n = 1; n < count; ++n) {
-			add_plugin (plugin_factory (plugin));
+			boost::shared_ptr<Plugin> p = _session.plugin_pool ().take (plugin->get_info ());
+			add_plugin (p ? p : plugin_factory (plugin));
 		}
 	}
 
@@ -2990,6 +3335,7 @@ PluginInsert::PluginControl::actually_set_value (double user_val, PBD::Controlla
 	for (Plugins::iterator i = _plugin->_plugins.begin(); i != _plugin->_plugins.end(); ++i) {
 		(*i)->set_parameter (_list->parameter().id(), user_val);
 	}
+	g_atomic_int_set (&_plugin->_silence_wake, 1);
 
 	boost::shared_ptr<Plugin> iasp = _plugin->_impulseAnalysisPlugin.lock();
 	if (iasp) {
@@ -3226,6 +3572,8 @@ PluginInsert::load_preset (ARDOUR::Plugin::PresetRecord pr)
 		iasp->load_preset (pr);
 	}
 
+	g_atomic_int_set (&_silence_wake, 1);
+
 	return ok;
 }
 
@@ -3240,6 +3588,8 @@ PluginInsert::realtime_handle_transport_stopped ()
 void
 PluginInsert::realtime_locate (bool for_loop_end)
 {
+	_silent_samples   = 0;
+	_skipping_silence = false;
 	for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i) {
 		(*i)->realtime_locate (for_loop_end);
 	}
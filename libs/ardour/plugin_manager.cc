@@ -416,6 +416,7 @@ PluginManager::refresh (bool cache_only)
 #endif //Native Mac VST SUPPORT
 
 #if (defined WINDOWS_VST_SUPPORT || defined LXVST_SUPPORT || defined MACVST_SUPPORT)
+		vstfx_save_index ();
 		if (!cache_only) {
 			string fn = Glib::build_filename (ARDOUR::user_cache_directory(), VST_BLACKLIST);
 			if (Glib::file_test (fn, Glib::FILE_TEST_EXISTS)) {
@@ -1027,6 +1028,10 @@ PluginManager::windows_vst_discover_from_path (string path, bool cache_only)
 
 	find_files_matching_filter (plugin_objects, path, windows_vst_filter, 0, false, true, true);
 
+	if (!cache_only && !cancelled ()) {
+		vstfx_scan_parallel (plugin_objects);
+	}
+
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x) {
 		ARDOUR::PluginScanMessage(_("VST"), *x, !cache_only && !cancelled());
 		windows_vst_discover (*x, cache_only || cancelled());
@@ -1347,6 +1352,10 @@ PluginManager::lxvst_discover_from_path (string path, bool cache_only)
 
 	find_files_matching_filter (plugin_objects, Config->get_plugin_path_lxvst(), lxvst_filter, 0, false, true, true);
 
+	if (!cache_only && !cancelled ()) {
+		vstfx_scan_parallel (plugin_objects);
+	}
+
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x) {
 		ARDOUR::PluginScanMessage(_("LXVST"), *x, !cache_only && !cancelled());
 		lxvst_discover (*x, cache_only || cancelled());
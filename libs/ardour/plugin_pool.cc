@@ -0,0 +1,342 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+
+#include "pbd/compose.h"
+#include "pbd/cpus.h"
+#include "pbd/error.h"
+#include "pbd/pthread_utils.h"
+#include "pbd/xml++.h"
+
+#include "ardour/debug.h"
+#include "ardour/plugin_manager.h"
+#include "ardour/plugin_pool.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/session.h"
+
+#include "pbd/i18n.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+/* instantiation time above which a plugin is mentioned in the log */
+static const int64_t slow_instantiation_usec = 100000;
+
+static PluginInfoPtr
+find_plugin_info (PluginType type, string const& unique_id)
+{
+	PluginManager& mgr (PluginManager::instance ());
+	PluginInfoList plugs;
+
+	switch (type) {
+	case ARDOUR::LADSPA:
+		plugs = mgr.ladspa_plugin_info ();
+		break;
+#ifdef LV2_SUPPORT
+	case ARDOUR::LV2:
+		plugs = mgr.lv2_plugin_info ();
+		break;
+#endif
+	case ARDOUR::Lua:
+		plugs = mgr.lua_plugin_info ();
+		break;
+	default:
+		return PluginInfoPtr ();
+	}
+
+	for (PluginInfoList::const_iterator i = plugs.begin (); i != plugs.end (); ++i) {
+		if ((*i)->unique_id == unique_id) {
+			return *i;
+		}
+	}
+	return PluginInfoPtr ();
+}
+
+PluginPool::PluginPool (Session& s)
+	: _session (s)
+	, _next_job (0)
+	, _thread (0)
+	, _quit (false)
+{
+}
+
+PluginPool::~PluginPool ()
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+		_quit = true;
+		_refill_cond.signal ();
+	}
+	if (_thread) {
+		_thread->join ();
+	}
+	clear ();
+}
+
+PluginPool::Concurrency
+PluginPool::concurrency (PluginType type)
+{
+	switch (type) {
+	case ARDOUR::LADSPA:
+	case ARDOUR::Lua:
+		return Concurrent;
+	case ARDOUR::LV2:
+		return Serialized;
+	default:
+		/* VST and AU plugins may only be instantiated by the GUI thread */
+		return GUIThreadOnly;
+	}
+}
+
+void
+PluginPool::clear ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	_idle.clear ();
+	_spares.clear ();
+	_refill_queue.clear ();
+}
+
+/** Instantiate the plugins used by the given routes concurrently. This
+ * returns once all of them have been created; until then nothing else may
+ * use the plugin formats which are pre-loaded.
+ */
+void
+PluginPool::preload (XMLNode const& routes)
+{
+	map<Key, uint32_t> uses;
+
+	assert (_jobs.empty ());
+
+	for (XMLNodeConstIterator r = routes.children ().begin (); r != routes.children ().end (); ++r) {
+		for (XMLNodeConstIterator p = (*r)->children ().begin (); p != (*r)->children ().end (); ++p) {
+			string     type_name;
+			string     unique_id;
+			PluginType type;
+
+			if ((*p)->name () != X_("Processor") || !(*p)->get_property ("type", type_name) || !(*p)->get_property ("unique-id", unique_id)) {
+				continue;
+			}
+
+			if (type_name == X_("ladspa") || type_name == X_("Ladspa")) {
+				type = ARDOUR::LADSPA;
+			} else if (type_name == X_("lv2")) {
+				type = ARDOUR::LV2;
+			} else if (type_name == X_("luaproc")) {
+				type = ARDOUR::Lua;
+			} else {
+				continue;
+			}
+
+			PluginInfoPtr info = find_plugin_info (type, unique_id);
+			if (!info) {
+				continue;
+			}
+
+			uint32_t count = 1;
+			(*p)->get_property ("count", count);
+
+			for (uint32_t n = 0; n < count; ++n) {
+				_jobs.push_back (Job (info));
+			}
+			uses[Key (type, unique_id)] += count;
+		}
+	}
+
+	if (_jobs.empty ()) {
+		return;
+	}
+
+	const int64_t  start     = g_get_monotonic_time ();
+	const uint32_t n_threads = min ((uint32_t) _jobs.size (), hardware_concurrency ());
+
+	vector<Glib::Threads::Thread*> threads;
+	g_atomic_int_set (&_next_job, 0);
+
+	for (uint32_t n = 0; n < n_threads; ++n) {
+		try {
+			threads.push_back (Glib::Threads::Thread::create (sigc::mem_fun (*this, &PluginPool::preload_worker)));
+		} catch (Glib::Threads::ThreadError const&) {
+			break;
+		}
+	}
+
+	if (threads.empty ()) {
+		preload_worker ();
+	}
+
+	for (vector<Glib::Threads::Thread*>::const_iterator t = threads.begin (); t != threads.end (); ++t) {
+		(*t)->join ();
+	}
+
+	int64_t  total  = 0;
+	uint32_t loaded = 0;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+
+		for (vector<Job>::const_iterator j = _jobs.begin (); j != _jobs.end (); ++j) {
+			if (!j->plugin) {
+				continue;
+			}
+			DEBUG_TRACE (DEBUG::PluginManager, string_compose ("pre-loaded %1 in %2 ms\n", j->info->name, j->usec / 1000.0));
+			if (j->usec > slow_instantiation_usec) {
+				PBD::info << string_compose (_("Plugin '%1' took %2 ms to instantiate"), j->info->name, j->usec / 1000) << endmsg;
+			}
+			_idle[Key (j->info->type, j->info->unique_id)].push_back (j->plugin);
+			total += j->usec;
+			++loaded;
+		}
+
+		const uint32_t spares = Config->get_spare_plugin_instances ();
+
+		for (map<Key, uint32_t>::const_iterator u = uses.begin (); spares > 0 && u != uses.end (); ++u) {
+			if (u->second < 2 || concurrency (u->first.first) != Concurrent) {
+				continue;
+			}
+			_spares[u->first] = find_plugin_info (u->first.first, u->first.second);
+			for (uint32_t n = 0; n < spares; ++n) {
+				queue_refill (u->first);
+			}
+		}
+	}
+
+	_jobs.clear ();
+
+	PBD::info << string_compose (_("Pre-loaded %1 plugin instances in %2 ms (%3 ms instantiation time)"),
+	                        loaded, (g_get_monotonic_time () - start) / 1000, total / 1000) << endmsg;
+}
+
+void
+PluginPool::preload_worker ()
+{
+	pthread_set_name ("PluginPreload");
+
+	while (true) {
+		const gint n = g_atomic_int_add (&_next_job, 1);
+		if (n >= (gint) _jobs.size ()) {
+			break;
+		}
+
+		Job& job (_jobs[n]);
+
+		if (concurrency (job.info->type) == Serialized) {
+			Glib::Threads::Mutex::Lock lm (_serial_lock);
+			job.plugin = instantiate (job.info, job.usec);
+		} else {
+			job.plugin = instantiate (job.info, job.usec);
+		}
+	}
+}
+
+PluginPtr
+PluginPool::instantiate (PluginInfoPtr info, int64_t& usec)
+{
+	const int64_t start = g_get_monotonic_time ();
+	PluginPtr     p     = info->load (_session);
+	usec = g_get_monotonic_time () - start;
+	return p;
+}
+
+/** @return an idle instance of the given plugin, if there is one */
+PluginPtr
+PluginPool::take (PluginInfoPtr info)
+{
+	const Key key (info->type, info->unique_id);
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	map<Key, list<PluginPtr> >::iterator i = _idle.find (key);
+	if (i == _idle.end () || i->second.empty ()) {
+		return PluginPtr ();
+	}
+
+	PluginPtr p = i->second.front ();
+	i->second.pop_front ();
+
+	if (_spares.find (key) != _spares.end ()) {
+		queue_refill (key);
+	}
+
+	return p;
+}
+
+/* called with _lock held */
+void
+PluginPool::queue_refill (Key const& key)
+{
+	_refill_queue.push_back (key);
+	if (!_thread) {
+		_thread = Glib::Threads::Thread::create (sigc::mem_fun (*this, &PluginPool::refill_thread));
+	}
+	_refill_cond.signal ();
+}
+
+/** @return an idle instance of the given plugin, or a new one */
+PluginPtr
+PluginPool::load (PluginInfoPtr info)
+{
+	PluginPtr p = take (info);
+
+	if (!p) {
+		int64_t usec;
+		p = instantiate (info, usec);
+		DEBUG_TRACE (DEBUG::PluginManager, string_compose ("instantiated %1 in %2 ms\n", info->name, usec / 1000.0));
+		if (usec > slow_instantiation_usec) {
+			PBD::info << string_compose (_("Plugin '%1' took %2 ms to instantiate"), info->name, usec / 1000) << endmsg;
+		}
+	}
+
+	return p;
+}
+
+void
+PluginPool::refill_thread ()
+{
+	pthread_set_name ("PluginPool");
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	while (!_quit) {
+		if (_refill_queue.empty ()) {
+			_refill_cond.wait (_lock);
+			continue;
+		}
+
+		const Key key = _refill_queue.front ();
+		_refill_queue.pop_front ();
+
+		map<Key, PluginInfoPtr>::const_iterator s = _spares.find (key);
+		if (s == _spares.end () || _idle[key].size () >= Config->get_spare_plugin_instances ()) {
+			continue;
+		}
+
+		PluginInfoPtr info = s->second;
+		int64_t       usec;
+
+		lm.release ();
+		PluginPtr p = instantiate (info, usec);
+		lm.acquire ();
+
+		/* the pool may have been cleared meanwhile */
+		if (p && !_quit && _spares.find (key) != _spares.end ()) {
+			_idle[key].push_back (p);
+		}
+	}
+}
@@ -76,6 +76,7 @@ Processor::Processor(Session& session, const string& name)
 	, _capture_offset (0)
 	, _playback_offset (0)
 	, _loop_location (0)
+	, _dsp_stats_reset (0)
 {
 }
 
@@ -99,6 +100,7 @@ Processor::Processor (const Processor& other)
 	, _capture_offset (0)
 	, _playback_offset (0)
 	, _loop_location (other._loop_location)
+	, _dsp_stats_reset (0)
 {
 }
 
@@ -107,6 +109,22 @@ Processor::~Processor ()
 	DEBUG_TRACE (DEBUG::Destruction, string_compose ("processor %1 destructor\n", _name));
 }
 
+void
+Processor::reset_dsp_stats ()
+{
+	/* applied by the process thread with the next measurement */
+	g_atomic_int_set (&_dsp_stats_reset, 1);
+}
+
+void
+Processor::add_dsp_time (uint64_t usec)
+{
+	if (g_atomic_int_compare_and_exchange (&_dsp_stats_reset, 1, 0)) {
+		_dsp_stats.reset ();
+	}
+	_dsp_stats.add (usec);
+}
+
 XMLNode&
 Processor::get_state (void)
 {
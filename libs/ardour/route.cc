@@ -116,6 +116,7 @@ Route::Route (Session& sess, string name, PresentationInfo::Flag flag, DataType
 	, _pending_process_reorder (0)
 	, _pending_listen_change (0)
 	, _pending_signals (0)
+	, _dsp_stats_reset (0)
 	, _meter_point (MeterPostFader)
 	, _pending_meter_point (MeterPostFader)
 	, _denormal_protection (false)
@@ -463,6 +464,13 @@ Route::process_output_buffers (BufferSet& bufs,
 
 	samplecnt_t latency = 0;
 
+	const bool    profile     = Config->get_dsp_profiling ();
+	const int64_t route_start = profile ? g_get_monotonic_time () : 0;
+
+	/* audio is known to be silent after the disk reader played back a gap,
+	 * until a processor which may produce signal */
+	bool known_silent = false;
+
 	for (ProcessorList::const_iterator i = _processors.begin(); i != _processors.end(); ++i) {
 
 		bool re_inject_oob_data = false;
@@ -512,14 +520,30 @@ Route::process_output_buffers (BufferSet& bufs,
 			latency += (*i)->effective_latency ();
 		}
 
+		const int64_t run_start = profile ? g_get_monotonic_time () : 0;
+
+		if (known_silent) {
+			(*i)->set_silent_input ();
+		}
+
 		if (speed < 0) {
 			(*i)->run (bufs, start_sample + latency, end_sample + latency, pspeed, nframes, *i != _processors.back());
 		} else {
 			(*i)->run (bufs, start_sample - latency, end_sample - latency, pspeed, nframes, *i != _processors.back());
 		}
 
+		if (profile) {
+			(*i)->add_dsp_time (g_get_monotonic_time () - run_start);
+		}
+
 		bufs.set_count ((*i)->output_streams());
 
+		if ((*i) == _disk_reader) {
+			known_silent = _disk_reader->playback_silent ();
+		} else if (known_silent) {
+			known_silent = (*i)->keeps_silence ();
+		}
+
 		if (re_inject_oob_data) {
 			write_out_of_band_data (bufs, nframes);
 		}
@@ -530,6 +554,31 @@ Route::process_output_buffers (BufferSet& bufs,
 		}
 #endif
 	}
+
+	if (profile) {
+		if (g_atomic_int_compare_and_exchange (&_dsp_stats_reset, 1, 0)) {
+			_dsp_stats.reset ();
+		}
+		_dsp_stats.add (g_get_monotonic_time () - route_start);
+	}
+}
+
+/** @return execution time of all processors of this route per cycle */
+DSPStats
+Route::dsp_stats () const
+{
+	return _dsp_stats;
+}
+
+void
+Route::reset_dsp_stats ()
+{
+	g_atomic_int_set (&_dsp_stats_reset, 1);
+
+	Glib::Threads::RWLock::ReaderLock lm (_processor_lock);
+	for (ProcessorList::const_iterator i = _processors.begin(); i != _processors.end(); ++i) {
+		(*i)->reset_dsp_stats ();
+	}
 }
 
 void
@@ -77,6 +77,7 @@
 #include "ardour/control_protocol_manager.h"
 #include "ardour/data_type.h"
 #include "ardour/debug.h"
+#include "ardour/decoded_audio_cache.h"
 #include "ardour/disk_reader.h"
 #include "ardour/directory_names.h"
 #include "ardour/filename_extensions.h"
@@ -93,6 +94,7 @@
 #include "ardour/playlist_factory.h"
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
+#include "ardour/plugin_pool.h"
 #include "ardour/process_thread.h"
 #include "ardour/profile.h"
 #include "ardour/rc_configuration.h"
@@ -111,6 +113,7 @@
 #include "ardour/session_playlists.h"
 #include "ardour/smf_source.h"
 #include "ardour/solo_isolate_control.h"
+#include "ardour/source_block_cache.h"
 #include "ardour/source_factory.h"
 #include "ardour/speakers.h"
 #include "ardour/tempo.h"
@@ -189,6 +192,7 @@ Session::Session (AudioEngine &eng,
 	, _session_range_is_free (true)
 	, _silent (false)
 	, _remaining_latency_preroll (0)
+	, _dsp_stats_reset (0)
 	, _engine_speed (1.0)
 	, _transport_speed (0)
 	, _default_transport_speed (1.0)
@@ -241,8 +245,10 @@ Session::Session (AudioEngine &eng,
 	, lua (lua_newstate (&PBD::ReallocPool::lalloc, &_mempool))
 	, _n_lua_scripts (0)
 	, _butler (new Butler (*this))
+	, _plugin_pool (new PluginPool (*this))
 	, _transport_fsm (new TransportFSM (*this))
 	, _post_transport_work (0)
+	, _playback_budget_short (false)
 	, _locations (new Locations (*this))
 	, _ignore_skips_updates (false)
 	, _rt_thread_active (false)
@@ -323,6 +329,7 @@ Session::Session (AudioEngine &eng,
 	, _selection (new CoreSelection (*this))
 	, _global_locate_pending (false)
 	, _had_destructive_tracks (false)
+	, _block_cache (new SourceBlockCache ((size_t) Config->get_source_block_cache_size () * 1048576))
 {
 	created_with = string_compose ("%1 %2", PROGRAM_NAME, revision);
 
@@ -563,6 +570,7 @@ Session::destroy ()
 	remove_pending_capture_state ();
 
 	Analyser::flush ();
+	DecodedAudioCache::flush ();
 
 	_state_of_the_state = StateOfTheState (CannotSave | Deletion);
 
@@ -635,6 +643,9 @@ Session::destroy ()
 	delete _butler;
 	_butler = 0;
 
+	delete _plugin_pool;
+	_plugin_pool = 0;
+
 	delete _all_route_group;
 
 	DEBUG_TRACE (DEBUG::Destruction, "delete route groups\n");
@@ -718,6 +729,8 @@ Session::destroy ()
 		sources.clear ();
 	}
 
+	delete _block_cache; _block_cache = 0;
+
 	/* not strictly necessary, but doing it here allows the shared_ptr debugging to work */
 	_playlists.reset ();
 
@@ -2064,6 +2077,7 @@ Session::set_sample_rate (samplecnt_t frames_per_second)
 	sync_time_vars();
 
 	clear_clicks ();
+	_plugin_pool->clear ();
 	reset_write_sources (false);
 
 	DiskReader::alloc_loop_declick (nominal_sample_rate());
@@ -4470,6 +4484,7 @@ Session::add_source (boost::shared_ptr<Source> source)
 			if (Config->get_auto_analyse_audio()) {
 				Analyser::queue_source_for_analysis (source, false);
 			}
+			afs->queue_for_decoding ();
 		}
 
 		source->DropReferences.connect_same_thread (*this, boost::bind (&Session::remove_source, this, boost::weak_ptr<Source> (source)));
@@ -20,11 +20,16 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
 #include "pbd/stacktrace.h"
 
 #include "ardour/butler.h"
+#include "ardour/debug.h"
+#include "ardour/disk_io.h"
 #include "ardour/disk_reader.h"
 #include "ardour/route.h"
 #include "ardour/session.h"
@@ -76,6 +81,130 @@ Session::schedule_capture_buffering_adjustment ()
 	_butler->schedule_transport_work ();
 }
 
+DiskIOStats
+Session::playback_io_stats () const
+{
+	DiskIOStats stats;
+	boost::shared_ptr<RouteList> rl = routes.reader ();
+	for (RouteList::const_iterator i = rl->begin (); i != rl->end (); ++i) {
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+		if (tr) {
+			stats.merge (tr->playback_io_stats ());
+		}
+	}
+	return stats;
+}
+
+DiskIOStats
+Session::capture_io_stats () const
+{
+	DiskIOStats stats;
+	boost::shared_ptr<RouteList> rl = routes.reader ();
+	for (RouteList::const_iterator i = rl->begin (); i != rl->end (); ++i) {
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+		if (tr) {
+			stats.merge (tr->capture_io_stats ());
+		}
+	}
+	return stats;
+}
+
+void
+Session::reset_io_stats ()
+{
+	boost::shared_ptr<RouteList> rl = routes.reader ();
+	for (RouteList::const_iterator i = rl->begin (); i != rl->end (); ++i) {
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+		if (tr) {
+			tr->reset_io_stats ();
+		}
+	}
+}
+
+/** Distribute the "playback-buffer-budget" among all tracks, in proportion
+ * to their playlist density and measured read cost. Sparse or empty tracks
+ * get a smaller, dense or slow tracks a larger buffer than the preset.
+ *
+ * This only sets the planned size, tracks resize their buffers in
+ * adjust_playback_buffering().
+ *
+ * @return true if any track's buffer size needs to change
+ */
+bool
+Session::plan_playback_buffering (boost::shared_ptr<RouteList> rl)
+{
+	const samplecnt_t preset = _butler->audio_playback_buffer_size ();
+	const double      budget = Config->get_playback_buffer_budget () * 1048576.0 / sizeof (Sample);
+
+	std::vector<boost::shared_ptr<Track> > tracks;
+	std::vector<float>                     demand;
+	double                                 mean_cost = 0;
+	uint32_t                               n_costs   = 0;
+	bool                                   changed   = false;
+
+	for (RouteList::iterator i = rl->begin(); i != rl->end(); ++i) {
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+		if (!tr || tr->data_type () != DataType::AUDIO) {
+			continue;
+		}
+		if (budget == 0) {
+			/* fixed size, as given by the buffering preset */
+			changed |= tr->playback_buffer_size () != preset;
+			tr->set_playback_buffer_size (0);
+			continue;
+		}
+		tracks.push_back (tr);
+		if (tr->playback_read_cost () > 0) {
+			mean_cost += tr->playback_read_cost ();
+			++n_costs;
+		}
+	}
+
+	if (tracks.empty ()) {
+		return changed;
+	}
+
+	if (n_costs > 0) {
+		mean_cost /= n_costs;
+	}
+
+	std::vector<uint32_t> channels;
+
+	for (std::vector<boost::shared_ptr<Track> >::const_iterator t = tracks.begin (); t != tracks.end (); ++t) {
+		/* layering beyond 4 regions deep, and read cost more than twice
+		 * the average, does not buy any more buffer space */
+		float d = std::min (4.f, (*t)->playback_density ());
+		if ((*t)->playback_read_cost () > 0 && mean_cost > 0) {
+			d *= std::max (0.5, std::min (2.0, (*t)->playback_read_cost () / mean_cost));
+		}
+		demand.push_back (d);
+		channels.push_back ((*t)->n_channels ().n_audio ());
+	}
+
+	std::vector<samplecnt_t> sizes;
+	const bool fits = DiskReader::plan_buffer_sizes (demand, channels, budget, preset, sizes);
+
+	if (!fits && !_playback_budget_short) {
+		warning << string_compose (_("The playback buffer budget of %1 MB is too small for %2 tracks, buffers will be smaller than a quarter of the buffering preset"),
+		                           Config->get_playback_buffer_budget (), tracks.size ()) << endmsg;
+	}
+	_playback_budget_short = !fits;
+
+	for (size_t n = 0; n < tracks.size (); ++n) {
+		const samplecnt_t size = sizes[n];
+		const samplecnt_t current = tracks[n]->playback_buffer_size ();
+
+		/* ignore changes of less than 25%, resizing requires a refill */
+		if (4 * llabs (size - current) > current) {
+			DEBUG_TRACE (DEBUG::Butler, string_compose ("%1: playback buffer %2 -> %3 samples (demand %4)\n", tracks[n]->name (), current, size, demand[n]));
+			tracks[n]->set_playback_buffer_size (size);
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
 void
 Session::request_overwrite_buffer (boost::shared_ptr<Track> t, OverwriteReason why)
 {
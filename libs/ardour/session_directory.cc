@@ -250,6 +250,12 @@ SessionDirectory::backup_path () const
 	return Glib::build_filename (m_root_path, backup_dir_name);
 }
 
+const std::string
+SessionDirectory::decoded_path () const
+{
+	return Glib::build_filename (m_root_path, decoded_dir_name);
+}
+
 const vector<std::string>
 SessionDirectory::sub_directories () const
 {
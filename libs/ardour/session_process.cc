@@ -94,8 +94,18 @@ Session::process (pframes_t nframes)
 
 	_engine.main_thread()->get_buffers ();
 
+	const bool    profile = Config->get_dsp_profiling ();
+	const int64_t start   = profile ? g_get_monotonic_time () : 0;
+
 	(this->*process_function) (nframes);
 
+	if (profile) {
+		if (g_atomic_int_compare_and_exchange (&_dsp_stats_reset, 1, 0)) {
+			_dsp_stats.reset ();
+		}
+		_dsp_stats.add (g_get_monotonic_time () - start);
+	}
+
 	/* realtime-safe meter-position and processor-order changes
 	 *
 	 * ideally this would be done in
@@ -160,6 +170,17 @@ Session::process (pframes_t nframes)
 	SendFeedback (); /* EMIT SIGNAL */
 }
 
+void
+Session::reset_dsp_stats ()
+{
+	g_atomic_int_set (&_dsp_stats_reset, 1);
+
+	boost::shared_ptr<RouteList> r = routes.reader ();
+	for (RouteList::const_iterator i = r->begin(); i != r->end(); ++i) {
+		(*i)->reset_dsp_stats ();
+	}
+}
+
 int
 Session::fail_roll (pframes_t nframes)
 {
@@ -116,6 +116,7 @@
 #include "ardour/midi_track.h"
 #include "ardour/playlist_factory.h"
 #include "ardour/playlist_source.h"
+#include "ardour/plugin_pool.h"
 #include "ardour/port.h"
 #include "ardour/processor.h"
 #include "ardour/progress.h"
@@ -135,6 +136,7 @@
 #include "ardour/silentfilesource.h"
 #include "ardour/smf_source.h"
 #include "ardour/sndfilesource.h"
+#include "ardour/source_block_cache.h"
 #include "ardour/source_factory.h"
 #include "ardour/speakers.h"
 #include "ardour/template_utils.h"
@@ -1724,7 +1726,13 @@ Session::set_state (const XMLNode& node, int version)
 	if ((child = find_named_node (node, "Routes")) == 0) {
 		error << _("Session: XML state has no routes section") << endmsg;
 		goto out;
-	} else if (load_routes (*child, version)) {
+	}
+
+	if (version >= 3000 && Config->get_preload_plugins ()) {
+		_plugin_pool->preload (*child);
+	}
+
+	if (load_routes (*child, version)) {
 		goto out;
 	}
 
@@ -3687,6 +3695,8 @@ Session::cleanup_sources (CleanupReport& rep)
 	/* drop last Source references */
 	dead_sources.clear ();
 
+	cleanup_decoded_audio ();
+
 	/* dump the history list, remove references */
 
 	_history.clear ();
@@ -3704,6 +3714,32 @@ out:
 	return ret;
 }
 
+/** Remove decoded audio files which do not belong to a source of this session */
+void
+Session::cleanup_decoded_audio ()
+{
+	set<string> used;
+
+	{
+		Glib::Threads::Mutex::Lock lm (source_lock);
+		for (SourceMap::const_iterator i = sources.begin (); i != sources.end (); ++i) {
+			boost::shared_ptr<AudioFileSource> afs = boost::dynamic_pointer_cast<AudioFileSource> (i->second);
+			if (afs && afs->decode_to_cache ()) {
+				used.insert (afs->decoded_cache_path ());
+			}
+		}
+	}
+
+	vector<string> files;
+	find_files_matching_pattern (files, Searchpath (session_directory ().decoded_path ()), string ("*.f32"));
+
+	for (vector<string>::const_iterator f = files.begin (); f != files.end (); ++f) {
+		if (used.find (*f) == used.end ()) {
+			::g_unlink (f->c_str ());
+		}
+	}
+}
+
 int
 Session::cleanup_trash_sources (CleanupReport& rep)
 {
@@ -4154,6 +4190,9 @@ Session::config_changed (std::string p, bool ours)
 
 		first_file_header_format_reset = false;
 
+		/* FLAC capture uses disk I/O threads by default */
+		_butler->reset_io_threads ();
+
 	} else if (p == "native-file-data-format") {
 
 		if (!first_file_data_format_reset) {
@@ -4234,6 +4273,10 @@ Session::config_changed (std::string p, bool ours)
 	} else if (p == "loop-fade-choice") {
 		last_loopend = 0; /* force locate to refill buffers with new loop boundary data */
 		auto_loop_changed (_locations->auto_loop_location());
+	} else if (p == "source-block-cache-size") {
+		if (_block_cache) {
+			_block_cache->set_max_bytes ((size_t) Config->get_source_block_cache_size () * 1048576);
+		}
 	}
 
 	set_dirty ();
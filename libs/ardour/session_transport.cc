@@ -1163,6 +1163,7 @@ Session::butler_transport_work ()
 		/* need to prevent concurrency with ARDOUR::Reader::run(),
 		 * DiskWriter::adjust_buffering() re-allocates the ringbuffer */
 		Glib::Threads::Mutex::Lock lx (AudioEngine::instance()->process_lock ());
+		plan_playback_buffering (r);
 		for (RouteList::iterator i = r->begin(); i != r->end(); ++i) {
 			boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
 			if (tr) {
@@ -1281,6 +1282,18 @@ Session::non_realtime_locate ()
 		tf = _transport_sample;
 		start = get_microseconds ();
 
+		/* have the OS read the target window of all tracks at once,
+		 * rather than each refill below waiting for cold storage in turn.
+		 */
+		for (RouteList::iterator i = rl->begin(); i != rl->end(); ++i) {
+			boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+			if (tr) {
+				tr->prefetch (tf);
+			}
+		}
+
+		DEBUG_TRACE (DEBUG::Transport, string_compose ("locate prefetch issued after %1 usecs\n", get_microseconds () - start));
+
 		for (RouteList::iterator i = rl->begin(); i != rl->end(); ++i, ++nt) {
 			(*i)->non_realtime_locate (tf);
 			if (sc != g_atomic_int_get (&_seek_counter)) {
@@ -1416,6 +1429,12 @@ Session::non_realtime_stop (bool abort, int on_entry, bool& finished)
 		}
 	}
 
+	/* redistribute playback buffer space, using read costs measured while rolling */
+	if (Config->get_playback_buffer_budget () > 0 && !abort && plan_playback_buffering (r)) {
+		SessionEvent *ev = new SessionEvent (SessionEvent::AdjustPlaybackBuffering, SessionEvent::Add, SessionEvent::Immediate, 0, 0, 0.0);
+		queue_event (ev);
+	}
+
 	/* If we are not synced to a "true" external master, and we're not
 	 * handling an explicit locate, we should consider whether or not to
 	 * "auto-return". This could mean going to a specifically requested
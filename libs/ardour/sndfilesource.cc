@@ -26,14 +26,25 @@
 #include "libardour-config.h"
 #endif
 
+#include <algorithm>
 #include <cstring>
 #include <cerrno>
 #include <climits>
 #include <cstdarg>
 #include <fcntl.h>
+#include <vector>
 
 #include <sys/stat.h>
 
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#ifndef PLATFORM_WINDOWS
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include <glib.h>
 #include "pbd/gstdio_compat.h"
 
@@ -60,6 +71,16 @@ const Source::Flag SndFileSource::default_writable_flags = Source::Flag (
 		Source::RemovableIfEmpty |
 		Source::CanRename );
 
+/* capture files are preallocated in large extents ahead of the write
+ * position, to limit fragmentation of long multi-track recordings.
+ */
+static const off_t capture_prealloc_bytes = 64 * 1048576;
+
+/* writeback of captured data is started each time this much was written;
+ * data written before the previous range is dropped from the page cache.
+ */
+static const off_t capture_write_behind_bytes = 4 * 1048576;
+
 SndFileSource::SndFileSource (Session& s, const XMLNode& node)
 	: Source(s, node)
 	, AudioFileSource (s, node)
@@ -323,6 +344,17 @@ SndFileSource::init_sndfile ()
 
 	memset (&_info, 0, sizeof(_info));
 
+	_fd           = -1;
+	_preallocated = 0;
+	_write_behind = 0;
+	_drop_pending = 0;
+	_drop_behind  = 0;
+
+	_map_addr     = 0;
+	_map_length   = 0;
+	_map_data     = 0;
+	_map_frames   = 0;
+
 	AudioFileSource::HeaderPositionOffsetChanged.connect_same_thread (header_position_connection, boost::bind (&SndFileSource::handle_header_position_change, this));
 }
 
@@ -330,6 +362,9 @@ void
 SndFileSource::close ()
 {
 	if (_sndfile) {
+		release_preallocation ();
+		unmap_file ();
+		_fd = -1;
 		sf_close (_sndfile);
 		_sndfile = 0;
 		file_closed ();
@@ -383,6 +418,31 @@ SndFileSource::open ()
 
 	_length = _info.frames;
 
+	/* libsndfile owns the descriptor, we only use it for
+	 * allocation and caching hints */
+	_fd = fd;
+
+	if (writable ()) {
+		struct stat st;
+		if (fstat (fd, &st) == 0) {
+			_preallocated = st.st_size;
+			_write_behind = st.st_size;
+			_drop_pending = st.st_size;
+			_drop_behind  = st.st_size;
+		}
+	}
+
+#ifdef POSIX_FADV_SEQUENTIAL
+	if (!writable ()) {
+		/* playback reads are mostly sequential, allow for a larger readahead window */
+		posix_fadvise (fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+	}
+#endif
+
+	if (can_map ()) {
+		map_file ();
+	}
+
 #ifdef HAVE_RF64_RIFF
 	if (_file_is_new && _length == 0 && writable()) {
 		if (_flags & RF64_RIFF) {
@@ -482,6 +542,10 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
                 return cnt;
         }
 
+        if ((nread = read_decoded (dst, start, cnt)) >= 0) {
+		return nread;
+        }
+
         if (const_cast<SndFileSource*>(this)->open()) {
 		error << string_compose (_("could not open file %1 for reading."), _path) << endmsg;
 		return 0;
@@ -513,6 +577,10 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 		memset (dst+file_cnt, 0, sizeof (Sample) * delta);
 	}
 
+	if (file_cnt && _map_data && start + file_cnt <= _map_frames) {
+		return read_mapped (dst, start, file_cnt);
+	}
+
 	if (file_cnt) {
 
 		if (sf_seek (_sndfile, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
@@ -563,6 +631,55 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 	return nread;
 }
 
+/** Copy one channel straight from the mapped file into @param dst.
+ * The caller ensures that the range is within the mapping.
+ */
+samplecnt_t
+SndFileSource::read_mapped (Sample* dst, samplepos_t start, samplecnt_t cnt) const
+{
+	const int    nchan = _info.channels;
+	const float* src   = _map_data + start * nchan + _channel;
+
+	if (nchan == 1 && _gain == 1.f) {
+		memcpy (dst, src, sizeof (Sample) * cnt);
+	} else if (_gain == 1.f) {
+		for (samplecnt_t n = 0; n < cnt; ++n) {
+			dst[n] = *src;
+			src += nchan;
+		}
+	} else {
+		for (samplecnt_t n = 0; n < cnt; ++n) {
+			dst[n] = *src * _gain;
+			src += nchan;
+		}
+	}
+
+	return cnt;
+}
+
+bool
+SndFileSource::cacheable () const
+{
+	/* mapped files are read straight from the page cache */
+	return AudioFileSource::cacheable () && !_map_data;
+}
+
+bool
+SndFileSource::decode_to_cache () const
+{
+	if (writable ()) {
+		return false;
+	}
+	switch (_info.format & SF_FORMAT_TYPEMASK) {
+	case SF_FORMAT_FLAC:
+	case SF_FORMAT_OGG:
+		/* decoding and seeking are expensive */
+		return true;
+	default:
+		return false;
+	}
+}
+
 samplecnt_t
 SndFileSource::write_unlocked (Sample *data, samplecnt_t cnt)
 {
@@ -599,9 +716,255 @@ SndFileSource::nondestructive_write_unlocked (Sample *data, samplecnt_t cnt)
 		compute_and_write_peaks (data, sample_pos, cnt, true, true);
 	}
 
+	write_behind ();
+
 	return cnt;
 }
 
+/** Preallocate capture files in large extents, and keep written data
+ * from piling up in the page cache: start writeback of each new range
+ * and drop the one submitted two ranges earlier, which will not be
+ * re-read any time soon. Neither call waits for I/O.
+ */
+void
+SndFileSource::write_behind ()
+{
+#if defined (__linux__) && defined (FALLOC_FL_KEEP_SIZE)
+	if (_fd < 0) {
+		return;
+	}
+
+	struct stat st;
+	if (fstat (_fd, &st) != 0) {
+		return;
+	}
+
+	const off_t pos = st.st_size;
+
+	if (_preallocated >= 0 && pos + capture_prealloc_bytes / 2 > _preallocated) {
+		const off_t start = max (pos, _preallocated);
+		if (fallocate (_fd, FALLOC_FL_KEEP_SIZE, start, pos + capture_prealloc_bytes - start) == 0) {
+			_preallocated = pos + capture_prealloc_bytes;
+		} else {
+			/* not supported by the filesystem, do not try again */
+			_preallocated = -1;
+		}
+	}
+
+	if (pos - _write_behind >= capture_write_behind_bytes) {
+		/* only start writeback of the new range, do not wait for it */
+		sync_file_range (_fd, _write_behind, pos - _write_behind, SYNC_FILE_RANGE_WRITE);
+		if (_drop_pending > _drop_behind) {
+			/* writeback of this range has had a whole range's worth of
+			 * writes to complete. The kernel skips (rather than waits for)
+			 * pages that are still dirty or under writeback; those just
+			 * stay cached. */
+			posix_fadvise (_fd, _drop_behind, _drop_pending - _drop_behind, POSIX_FADV_DONTNEED);
+			_drop_behind = _drop_pending;
+		}
+		_drop_pending = _write_behind;
+		_write_behind = pos;
+	}
+#endif
+}
+
+/** Return preallocated, but unused space beyond the end of the file */
+void
+SndFileSource::release_preallocation ()
+{
+#if defined (__linux__) && defined (FALLOC_FL_KEEP_SIZE)
+	if (_fd < 0 || _preallocated <= 0) {
+		return;
+	}
+
+	struct stat st;
+	if (fstat (_fd, &st) == 0 && _preallocated > st.st_size) {
+		/* truncating to the current size frees blocks allocated past EOF */
+		if (ftruncate (_fd, st.st_size) != 0) {
+			warning << string_compose (_("SndFileSource: cannot release preallocated space of %1"), _path) << endmsg;
+		}
+	}
+
+	_preallocated = 0;
+#endif
+}
+
+/** Map a range of samples to a range of bytes in the file.
+ * The size of the header is not known, the range is extended to cover it.
+ * @return false for compressed formats
+ */
+bool
+SndFileSource::file_range (samplepos_t start, samplecnt_t cnt, off_t& offset, off_t& len) const
+{
+	off_t bytes;
+
+	switch (_info.format & SF_FORMAT_SUBMASK) {
+		case SF_FORMAT_PCM_S8:
+		case SF_FORMAT_PCM_U8:
+			bytes = 1;
+			break;
+		case SF_FORMAT_PCM_16:
+			bytes = 2;
+			break;
+		case SF_FORMAT_PCM_24:
+			bytes = 3;
+			break;
+		case SF_FORMAT_PCM_32:
+		case SF_FORMAT_FLOAT:
+			bytes = 4;
+			break;
+		case SF_FORMAT_DOUBLE:
+			bytes = 8;
+			break;
+		default:
+			return false;
+	}
+
+	const off_t frame = bytes * _info.channels;
+
+	offset = start * frame;
+	len    = cnt * frame + 65536;
+	return true;
+}
+
+/** @return true if the file holds float data in host byte order, which
+ * can be read directly from a mapping. Files that are still being written
+ * are never mapped, their length and header change while recording.
+ */
+bool
+SndFileSource::can_map () const
+{
+#ifdef PLATFORM_WINDOWS
+	return false;
+#else
+	if (writable () || _fd < 0 || _info.frames <= 0 || (_info.format & SF_FORMAT_SUBMASK) != SF_FORMAT_FLOAT) {
+		return false;
+	}
+
+	int endian = _info.format & SF_FORMAT_ENDMASK;
+
+	if (endian == SF_ENDIAN_FILE) {
+		switch (_info.format & SF_FORMAT_TYPEMASK) {
+			case SF_FORMAT_WAV:
+			case SF_FORMAT_WAVEX:
+			case SF_FORMAT_W64:
+			case SF_FORMAT_RF64:
+				endian = SF_ENDIAN_LITTLE;
+				break;
+			default:
+				/* CAF and AIFF may use either byte order, libsndfile does not tell */
+				return false;
+		}
+	}
+
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+	return endian == SF_ENDIAN_LITTLE || endian == SF_ENDIAN_CPU;
+#else
+	return endian == SF_ENDIAN_BIG || endian == SF_ENDIAN_CPU;
+#endif
+#endif
+}
+
+void
+SndFileSource::map_file ()
+{
+#ifndef PLATFORM_WINDOWS
+	assert (!_map_addr);
+
+	/* libsndfile does not expose the offset of the audio data, but
+	 * seeking to the first sample positions the descriptor there.
+	 */
+	if (sf_seek (_sndfile, 0, SEEK_SET) != 0) {
+		return;
+	}
+
+	const off_t data_offset = lseek (_fd, 0, SEEK_CUR);
+	const off_t data_length = (off_t) _info.frames * _info.channels * sizeof (float);
+	const off_t map_length  = data_offset + data_length;
+
+	if (data_offset <= 0 || (data_offset % sizeof (float)) != 0 || (off_t) (size_t) map_length != map_length) {
+		return;
+	}
+
+	struct stat st;
+	if (fstat (_fd, &st) != 0 || st.st_size < map_length) {
+		return;
+	}
+
+	void* addr = mmap (0, map_length, PROT_READ, MAP_SHARED, _fd, 0);
+
+	if (addr == MAP_FAILED) {
+		return;
+	}
+
+	float* data = (float*) ((char*) addr + data_offset);
+
+	/* verify the offset against what libsndfile reads from the file */
+	const samplecnt_t check = std::min ((samplecnt_t) _info.frames, (samplecnt_t) 256);
+	std::vector<float> buf (check * _info.channels);
+
+	if (sf_readf_float (_sndfile, &buf[0], check) != check || memcmp (&buf[0], data, buf.size () * sizeof (float))) {
+		munmap (addr, map_length);
+		return;
+	}
+
+#ifdef MADV_SEQUENTIAL
+	madvise (addr, map_length, MADV_SEQUENTIAL);
+#endif
+
+	_map_addr   = (char*) addr;
+	_map_length = map_length;
+	_map_data   = data;
+	_map_frames = _info.frames;
+#endif
+}
+
+void
+SndFileSource::unmap_file ()
+{
+#ifndef PLATFORM_WINDOWS
+	if (_map_addr) {
+		munmap (_map_addr, _map_length);
+	}
+#endif
+	_map_addr   = 0;
+	_map_length = 0;
+	_map_data   = 0;
+	_map_frames = 0;
+}
+
+void
+SndFileSource::readahead (samplepos_t start, samplecnt_t cnt) const
+{
+#ifdef POSIX_FADV_WILLNEED
+	Glib::Threads::Mutex::Lock lm (_lock);
+	off_t offset, len;
+	if (_fd >= 0 && file_range (start, cnt, offset, len)) {
+		posix_fadvise (_fd, offset, len, POSIX_FADV_WILLNEED);
+	}
+#endif
+}
+
+void
+SndFileSource::drop_cache (samplepos_t start, samplecnt_t cnt) const
+{
+#ifdef POSIX_FADV_DONTNEED
+	Glib::Threads::Mutex::Lock lm (_lock);
+	off_t offset, len;
+	if (_fd >= 0 && !writable () && file_range (start, cnt, offset, len)) {
+		posix_fadvise (_fd, offset, len, POSIX_FADV_DONTNEED);
+	}
+#endif
+}
+
+void
+SndFileSource::mark_streaming_write_completed (const Lock& lock)
+{
+	/* called when capture ends (DiskWriter::transport_stopped_wallclock) */
+	release_preallocation ();
+	AudioFileSource::mark_streaming_write_completed (lock);
+}
+
 int
 SndFileSource::update_header (samplepos_t when, struct tm& now, time_t tnow)
 {
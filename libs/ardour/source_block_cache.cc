@@ -0,0 +1,180 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "ardour/source_block_cache.h"
+
+using namespace ARDOUR;
+
+const samplecnt_t SourceBlockCache::block_size;
+
+SourceBlockCache::SourceBlockCache (size_t max_bytes)
+	: _max_blocks (max_bytes / (block_size * sizeof (Sample)))
+{
+	g_atomic_int_set (&_hits, 0);
+	g_atomic_int_set (&_misses, 0);
+}
+
+SourceBlockCache::~SourceBlockCache ()
+{
+	clear ();
+}
+
+SourceBlockCache::Shard&
+SourceBlockCache::shard (Key const& key)
+{
+	/* mix source and block, so that the blocks of a source spread over
+	 * all shards, and different sources do not share a shard sequence */
+	uint64_t h = key.first.get_id () * 0x9e3779b97f4a7c15ULL;
+	h ^= (uint64_t) key.second + (h << 6) + (h >> 2);
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	return _shards[h % n_shards];
+}
+
+size_t
+SourceBlockCache::shard_max_blocks () const
+{
+	if (_max_blocks == 0) {
+		return 0;
+	}
+	return std::max ((size_t) 1, _max_blocks / n_shards);
+}
+
+void
+SourceBlockCache::set_max_bytes (size_t max_bytes)
+{
+	_max_blocks = max_bytes / (block_size * sizeof (Sample));
+
+	const size_t max_blocks = shard_max_blocks ();
+
+	for (size_t n = 0; n < n_shards; ++n) {
+		Glib::Threads::Mutex::Lock lm (_shards[n].lock);
+		evict (_shards[n], max_blocks);
+	}
+}
+
+/* must be called with the shard's lock held */
+void
+SourceBlockCache::evict (Shard& s, size_t max_blocks)
+{
+	while (s.n_blocks > max_blocks) {
+		Block* b = s.lru.back ();
+		s.index.erase (b->key);
+		s.lru.pop_back ();
+		--s.n_blocks;
+		delete b;
+	}
+}
+
+bool
+SourceBlockCache::get (PBD::ID const& source, int64_t block, Sample* dst, samplecnt_t offset, samplecnt_t cnt)
+{
+	assert (offset >= 0 && offset + cnt <= block_size);
+
+	const Key key (source, block);
+	Shard&    s (shard (key));
+	Glib::Threads::Mutex::Lock lm (s.lock);
+
+	std::map<Key, BlockList::iterator>::iterator i = s.index.find (key);
+
+	if (i == s.index.end () || offset + cnt > (*i->second)->length) {
+		g_atomic_int_inc (&_misses);
+		return false;
+	}
+
+	memcpy (dst, (*i->second)->data + offset, sizeof (Sample) * cnt);
+
+	/* move to the front of the LRU list */
+	s.lru.splice (s.lru.begin (), s.lru, i->second);
+
+	g_atomic_int_inc (&_hits);
+	return true;
+}
+
+void
+SourceBlockCache::put (PBD::ID const& source, int64_t block, Sample const* src, samplecnt_t cnt)
+{
+	assert (cnt <= block_size);
+
+	const size_t max_blocks = shard_max_blocks ();
+
+	if (max_blocks == 0) {
+		return;
+	}
+
+	const Key key (source, block);
+	Shard&    s (shard (key));
+	Glib::Threads::Mutex::Lock lm (s.lock);
+
+	if (s.index.find (key) != s.index.end ()) {
+		/* added meanwhile by another reader */
+		return;
+	}
+
+	Block* b;
+
+	if (s.n_blocks >= max_blocks) {
+		/* re-use the least recently used block */
+		evict (s, max_blocks);
+		b = s.lru.back ();
+		s.index.erase (b->key);
+		s.lru.pop_back ();
+		b->key = key;
+	} else {
+		b = new Block (key);
+		++s.n_blocks;
+	}
+
+	memcpy (b->data, src, sizeof (Sample) * cnt);
+	b->length = cnt;
+
+	s.lru.push_front (b);
+	s.index[key] = s.lru.begin ();
+}
+
+void
+SourceBlockCache::drop (PBD::ID const& source)
+{
+	for (size_t n = 0; n < n_shards; ++n) {
+		Shard& s (_shards[n]);
+		Glib::Threads::Mutex::Lock lm (s.lock);
+
+		for (BlockList::iterator i = s.lru.begin (); i != s.lru.end (); ) {
+			if ((*i)->key.first == source) {
+				s.index.erase ((*i)->key);
+				delete *i;
+				i = s.lru.erase (i);
+				--s.n_blocks;
+			} else {
+				++i;
+			}
+		}
+	}
+}
+
+void
+SourceBlockCache::clear ()
+{
+	for (size_t n = 0; n < n_shards; ++n) {
+		Glib::Threads::Mutex::Lock lm (_shards[n].lock);
+		evict (_shards[n], 0);
+	}
+}
@@ -17,11 +17,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <boost/bind.hpp>
+
 #include "pbd/error.h"
 #include "pbd/failed_constructor.h"
 
 #include "ardour/audiofilesource.h"
 #include "ardour/debug.h"
+#include "ardour/session.h"
+#include "ardour/source_block_cache.h"
 #include "ardour/srcfilesource.h"
 
 #include "pbd/i18n.h"
@@ -39,26 +43,25 @@ SrcFileSource::SrcFileSource (Session& s, boost::shared_ptr<AudioFileSource> src
 	, _source_position(0)
 	, _target_position(0)
 	, _fract_position(0)
+	, _src_type (SRC_SINC_BEST_QUALITY)
 {
 	assert(_source->n_channels() == 1);
 
-	int src_type = SRC_SINC_BEST_QUALITY;
-
 	switch (srcq) {
 		case SrcBest:
-			src_type = SRC_SINC_BEST_QUALITY;
+			_src_type = SRC_SINC_BEST_QUALITY;
 			break;
 		case SrcGood:
-			src_type = SRC_SINC_MEDIUM_QUALITY;
+			_src_type = SRC_SINC_MEDIUM_QUALITY;
 			break;
 		case SrcQuick:
-			src_type = SRC_SINC_FASTEST;
+			_src_type = SRC_SINC_FASTEST;
 			break;
 		case SrcFast:
-			src_type = SRC_ZERO_ORDER_HOLD;
+			_src_type = SRC_ZERO_ORDER_HOLD;
 			break;
 		case SrcFastest:
-			src_type = SRC_LINEAR;
+			_src_type = SRC_LINEAR;
 			break;
 	}
 
@@ -70,10 +73,12 @@ SrcFileSource::SrcFileSource (Session& s, boost::shared_ptr<AudioFileSource> src
 	_src_buffer = new float[src_buffer_size];
 
 	int err;
-	if ((_src_state = src_new (src_type, 1, &err)) == 0) {
+	if ((_src_state = src_new (_src_type, 1, &err)) == 0) {
 		error << string_compose(_("Import: src_new() failed : %1"), src_strerror (err)) << endmsg ;
 		throw failed_constructor ();
 	}
+
+	_source->GainChanged.connect_same_thread (_source_gain_connection, boost::bind (&SrcFileSource::source_gain_changed, this));
 }
 
 SrcFileSource::~SrcFileSource ()
@@ -92,12 +97,38 @@ SrcFileSource::close ()
 	}
 }
 
+/** Cached and decoded data of this source were resampled from data read
+ * with the previous gain of the underlying source.
+ */
+void
+SrcFileSource::source_gain_changed ()
+{
+	if (SourceBlockCache* cache = _session.block_cache ()) {
+		cache->drop (id ());
+	}
+	drop_decoded_cache ();
+}
+
+/** Decoded data depends on the resampling ratio and quality as well as
+ * on the gain of the underlying source.
+ */
+std::string
+SrcFileSource::decoded_cache_id () const
+{
+	return string_compose ("%1:%2:%3:%4", _source->decoded_cache_id (), _ratio, _src_type, _source->gain ());
+}
+
 samplecnt_t
 SrcFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) const
 {
 	int err;
 	const double srccnt = cnt / _ratio;
 
+	samplecnt_t n;
+	if ((n = read_decoded (dst, start, cnt)) >= 0) {
+		return n;
+	}
+
 	if (_target_position != start) {
 		DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("SRC: reset %1 -> %2\n", _target_position, start));
 		src_reset(_src_state);
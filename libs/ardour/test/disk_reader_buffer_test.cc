@@ -0,0 +1,98 @@
+#include <vector>
+
+#include "ardour/disk_reader.h"
+
+#include "disk_reader_buffer_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (DiskReaderBufferTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static double
+total_size (vector<samplecnt_t> const& sizes, vector<uint32_t> const& channels)
+{
+	double total = 0;
+	for (size_t n = 0; n < sizes.size (); ++n) {
+		total += sizes[n] * (double) channels[n];
+	}
+	return total;
+}
+
+void
+DiskReaderBufferTest::demandTest ()
+{
+	const samplecnt_t preset = 480000;
+
+	vector<float>       demand;
+	vector<uint32_t>    channels;
+	vector<samplecnt_t> sizes;
+
+	/* an empty, a sparse, an average and a dense stereo track */
+	demand.push_back (0);
+	demand.push_back (.5);
+	demand.push_back (1);
+	demand.push_back (4);
+	channels.assign (4, 2);
+
+	const double budget = 8 * preset;
+
+	CPPUNIT_ASSERT (DiskReader::plan_buffer_sizes (demand, channels, budget, preset, sizes));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 4, sizes.size ());
+	CPPUNIT_ASSERT_EQUAL (preset / 4, sizes[0]);
+	CPPUNIT_ASSERT (sizes[1] < sizes[2]);
+	CPPUNIT_ASSERT (sizes[2] < sizes[3]);
+	CPPUNIT_ASSERT (sizes[3] <= 2 * preset);
+	CPPUNIT_ASSERT (total_size (sizes, channels) <= budget);
+}
+
+void
+DiskReaderBufferTest::smallBudgetTest ()
+{
+	const samplecnt_t preset = 480000;
+	const uint32_t    tracks = 256;
+
+	vector<float>       demand (tracks, 1.f);
+	vector<uint32_t>    channels (tracks, 2);
+	vector<samplecnt_t> sizes;
+
+	/* a quarter of the preset for 512 channels would need 64 presets */
+	const double budget = 16 * preset;
+
+	CPPUNIT_ASSERT (!DiskReader::plan_buffer_sizes (demand, channels, budget, preset, sizes));
+	CPPUNIT_ASSERT_EQUAL ((size_t) tracks, sizes.size ());
+	CPPUNIT_ASSERT (total_size (sizes, channels) <= budget);
+	CPPUNIT_ASSERT (sizes[0] > 0);
+	CPPUNIT_ASSERT (sizes[0] < preset / 4);
+	CPPUNIT_ASSERT_EQUAL (sizes[0], sizes[tracks - 1]);
+
+	/* with uneven demand the sum still stays within the budget */
+	demand[0] = 4;
+	demand[1] = 0;
+	CPPUNIT_ASSERT (!DiskReader::plan_buffer_sizes (demand, channels, budget, preset, sizes));
+	CPPUNIT_ASSERT (total_size (sizes, channels) <= budget);
+	CPPUNIT_ASSERT (sizes[1] > 0);
+}
+
+void
+DiskReaderBufferTest::dropBehindTest ()
+{
+	samplepos_t start;
+	samplecnt_t cnt;
+
+	/* data before the kept range is dropped when not looping */
+	CPPUNIT_ASSERT (DiskReader::drop_behind_range (100000, 10000, 48000, false, start, cnt));
+	CPPUNIT_ASSERT_EQUAL ((samplepos_t) 42000, start);
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 10000, cnt);
+
+	/* only down to the start of the source */
+	CPPUNIT_ASSERT (DiskReader::drop_behind_range (50000, 10000, 48000, false, start, cnt));
+	CPPUNIT_ASSERT_EQUAL ((samplepos_t) 0, start);
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 2000, cnt);
+
+	/* nothing behind the kept range yet */
+	CPPUNIT_ASSERT (!DiskReader::drop_behind_range (48000, 10000, 48000, false, start, cnt));
+
+	/* loop playback never drops data */
+	CPPUNIT_ASSERT (!DiskReader::drop_behind_range (100000, 10000, 48000, true, start, cnt));
+}
@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class DiskReaderBufferTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (DiskReaderBufferTest);
+	CPPUNIT_TEST (demandTest);
+	CPPUNIT_TEST (smallBudgetTest);
+	CPPUNIT_TEST (dropBehindTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void demandTest ();
+	void smallBudgetTest ();
+	void dropBehindTest ();
+};
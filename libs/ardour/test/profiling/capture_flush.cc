@@ -0,0 +1,98 @@
+/* Capture write benchmark: record N mono tracks for T seconds, and report
+ * the duration of the butler's per-track flushes (DiskWriter::do_flush).
+ *
+ * The capture is kept in the given session; use a scratch session.
+ */
+#include <cstdlib>
+#include <iostream>
+
+#include <glib.h>
+
+#include "pbd/compose.h"
+#include "ardour/ardour.h"
+#include "ardour/audioengine.h"
+#include "ardour/audio_track.h"
+#include "ardour/disk_io.h"
+#include "ardour/session.h"
+#include "test_util.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+int
+main (int argc, char* argv[])
+{
+	if (argc < 3) {
+		cerr << "Syntax: " << argv[0] << " <dir> <snapshot-name> [tracks (128)] [seconds (3600)]\n";
+		exit (EXIT_FAILURE);
+	}
+
+	const int tracks  = argc > 3 ? atoi (argv[3]) : 128;
+	const int seconds = argc > 4 ? atoi (argv[4]) : 3600;
+
+	ARDOUR::init (false, true, localedir);
+	create_and_start_dummy_backend ();
+
+	Session* session = load_session (argv[1], argv[2]);
+
+	list<boost::shared_ptr<AudioTrack> > tl = session->new_audio_track (1, 1, NULL, tracks, "capture-bench", PresentationInfo::max_order);
+
+	if ((int) tl.size () != tracks) {
+		cerr << "Cannot create " << tracks << " tracks\n";
+		exit (EXIT_FAILURE);
+	}
+
+	for (list<boost::shared_ptr<AudioTrack> >::iterator t = tl.begin (); t != tl.end (); ++t) {
+		(*t)->rec_enable_control ()->set_value (1, PBD::Controllable::NoGroup);
+	}
+
+	session->reset_io_stats ();
+	session->maybe_enable_record ();
+	session->request_transport_speed (1.0);
+
+	const int64_t start = g_get_monotonic_time ();
+	while (g_get_monotonic_time () - start < seconds * (int64_t) 1000000) {
+		g_usleep (100000);
+	}
+
+	session->request_stop ();
+	while (session->transport_rolling () || session->actively_recording ()) {
+		g_usleep (100000);
+	}
+
+	/* the butler completes the capture after the transport stopped */
+	g_usleep (1000000);
+
+	const DiskIOStats s (session->capture_io_stats ());
+	const int64_t elapsed = g_get_monotonic_time () - start;
+
+	cout << string_compose ("%1 tracks x %2 s, %3 flushes, %4 MB in %5 s (%6 MB/s)\n",
+			tracks, seconds, s.ops, s.bytes / 1048576, elapsed / 1e6,
+			(double) s.bytes / elapsed);
+	if (s.ops > 0) {
+		cout << string_compose ("flush duration [us]: avg %1  p50 %2  p95 %3  p99 %4  max %5\n",
+				s.total_usec / s.ops, (uint64_t) s.percentile (50), (uint64_t) s.percentile (95),
+				(uint64_t) s.percentile (99), s.max_usec);
+		cout << string_compose ("lowest buffer space %1%%\n", (int) (100 * s.min_headroom));
+		uint64_t prev = 0;
+		for (int b = 0; b < DiskIOStats::n_buckets; ++b) {
+			const uint64_t lim = DiskIOStats::bucket_limit (b);
+			if (s.histogram (b) > 0) {
+				if (lim > 0) {
+					cout << string_compose ("  <= %1 us: %2\n", lim, s.histogram (b));
+				} else {
+					cout << string_compose ("   > %1 us: %2\n", prev, s.histogram (b));
+				}
+			}
+			prev = lim;
+		}
+	}
+
+	AudioEngine::instance ()->remove_session ();
+	delete session;
+	stop_and_destroy_backend ();
+
+	return 0;
+}
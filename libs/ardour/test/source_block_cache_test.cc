@@ -0,0 +1,94 @@
+#include <vector>
+
+#include "ardour/source_block_cache.h"
+
+#include "source_block_cache_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (SourceBlockCacheTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static const samplecnt_t bs = SourceBlockCache::block_size;
+
+void
+SourceBlockCacheTest::basicTest ()
+{
+	SourceBlockCache cache (64 * bs * sizeof (Sample));
+	vector<Sample> data (bs);
+	vector<Sample> out (bs);
+
+	for (samplecnt_t i = 0; i < bs; ++i) {
+		data[i] = i;
+	}
+
+	PBD::ID a (1);
+	PBD::ID b (2);
+
+	CPPUNIT_ASSERT (cache.enabled ());
+	CPPUNIT_ASSERT (!cache.get (a, 0, &out[0], 0, bs));
+
+	cache.put (a, 0, &data[0], bs);
+	CPPUNIT_ASSERT (cache.get (a, 0, &out[0], 0, bs));
+	CPPUNIT_ASSERT_EQUAL (data[100], out[100]);
+
+	/* partial reads from within a block */
+	CPPUNIT_ASSERT (cache.get (a, 0, &out[0], 1000, 10));
+	CPPUNIT_ASSERT_EQUAL (1000.f, out[0]);
+	CPPUNIT_ASSERT_EQUAL (1009.f, out[9]);
+
+	/* same block index of another source */
+	CPPUNIT_ASSERT (!cache.get (b, 0, &out[0], 0, 1));
+
+	/* short block at the end of a source */
+	cache.put (b, 3, &data[0], 100);
+	CPPUNIT_ASSERT (cache.get (b, 3, &out[0], 0, 100));
+	CPPUNIT_ASSERT (!cache.get (b, 3, &out[0], 0, 101));
+
+	cache.drop (a);
+	CPPUNIT_ASSERT (!cache.get (a, 0, &out[0], 0, 1));
+	CPPUNIT_ASSERT (cache.get (b, 3, &out[0], 0, 1));
+
+	cache.set_max_bytes (0);
+	CPPUNIT_ASSERT (!cache.enabled ());
+	CPPUNIT_ASSERT (!cache.get (b, 3, &out[0], 0, 1));
+}
+
+void
+SourceBlockCacheTest::evictionTest ()
+{
+	/* one block per shard */
+	SourceBlockCache cache (16 * bs * sizeof (Sample));
+	vector<Sample> data (bs, 1.f);
+	vector<Sample> out (bs);
+
+	PBD::ID a (1);
+	PBD::ID b (2);
+
+	for (int64_t n = 0; n < 32; ++n) {
+		cache.put (a, n, &data[0], bs);
+	}
+
+	/* the most recently added block is kept, older ones were evicted */
+	CPPUNIT_ASSERT (cache.get (a, 31, &out[0], 0, 1));
+
+	int cached = 0;
+	for (int64_t n = 0; n < 32; ++n) {
+		if (cache.get (a, n, &out[0], 0, 1)) {
+			++cached;
+		}
+	}
+	CPPUNIT_ASSERT (cached <= 16);
+
+	/* adding a block evicts at most one other */
+	cache.put (b, 0, &data[0], bs);
+	CPPUNIT_ASSERT (cache.get (b, 0, &out[0], 0, 1));
+
+	int still_cached = 0;
+	for (int64_t n = 0; n < 32; ++n) {
+		if (cache.get (a, n, &out[0], 0, 1)) {
+			++still_cached;
+		}
+	}
+	CPPUNIT_ASSERT (still_cached >= cached - 1);
+}
@@ -0,0 +1,14 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class SourceBlockCacheTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (SourceBlockCacheTest);
+	CPPUNIT_TEST (basicTest);
+	CPPUNIT_TEST (evictionTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void basicTest ();
+	void evictionTest ();
+};
@@ -508,6 +508,12 @@ Track::do_refill ()
 	return _disk_reader->do_refill ();
 }
 
+int
+Track::do_refill (Sample* sum_buffer, Sample* mixdown_buffer, gain_t* gain_buffer)
+{
+	return _disk_reader->do_refill (sum_buffer, mixdown_buffer, gain_buffer);
+}
+
 int
 Track::do_flush (RunContext c, bool force)
 {
@@ -520,6 +526,12 @@ Track::set_pending_overwrite (OverwriteReason why)
 	_disk_reader->set_pending_overwrite (why);
 }
 
+void
+Track::prefetch (samplepos_t p)
+{
+	_disk_reader->prefetch (p);
+}
+
 int
 Track::seek (samplepos_t p, bool complete_refill)
 {
@@ -831,6 +843,49 @@ Track::adjust_playback_buffering ()
         }
 }
 
+samplecnt_t
+Track::playback_buffer_size () const
+{
+	return _disk_reader->playback_buffer_size ();
+}
+
+void
+Track::set_playback_buffer_size (samplecnt_t n)
+{
+	_disk_reader->set_playback_buffer_size (n);
+}
+
+float
+Track::playback_read_cost () const
+{
+	return _disk_reader->read_cost ();
+}
+
+float
+Track::playback_density () const
+{
+	return _disk_reader->playlist_density ();
+}
+
+DiskIOStats
+Track::playback_io_stats () const
+{
+	return _disk_reader->io_stats ();
+}
+
+DiskIOStats
+Track::capture_io_stats () const
+{
+	return _disk_writer->io_stats ();
+}
+
+void
+Track::reset_io_stats ()
+{
+	_disk_reader->reset_io_stats ();
+	_disk_writer->reset_io_stats ();
+}
+
 void
 Track::adjust_capture_buffering ()
 {
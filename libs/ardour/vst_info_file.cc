@@ -24,6 +24,8 @@
  */
 
 #include <cassert>
+#include <list>
+#include <map>
 
 #include <sys/types.h>
 
@@ -37,6 +39,7 @@
 #include <fcntl.h>
 #include <errno.h>
 
+#include <inttypes.h>
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -50,6 +53,8 @@
 #include "pbd/compose.h"
 
 #ifndef VST_SCANNER_APP
+#include "pbd/cpus.h"
+
 #include "ardour/plugin_manager.h" // scanner_bin_path
 #include "ardour/rc_configuration.h"
 #include "ardour/system_exec.h"
@@ -162,6 +167,28 @@ static void vstfx_blacklist (const char *id)
 	::fclose (blacklist_fd);
 }
 
+/** replace the blacklist, remove it if @param bl is empty */
+static void vstfx_write_blacklist (std::string const& bl)
+{
+	string fn = Glib::build_filename (ARDOUR::user_cache_directory (), VST_BLACKLIST);
+
+	::g_unlink (fn.c_str ());
+
+	assert (!Glib::file_test (fn, Glib::FILE_TEST_EXISTS));
+
+	if (bl.empty ()) {
+		return;
+	}
+
+	FILE * blacklist_fd = NULL;
+	if (! (blacklist_fd = g_fopen (fn.c_str (), "w"))) {
+		PBD::error << _("Cannot open VST blacklist.") << endmsg;;
+		return;
+	}
+	fprintf (blacklist_fd, "%s", bl.c_str ());
+	::fclose (blacklist_fd);
+}
+
 /** mark plugin as not blacklisted */
 static void vstfx_un_blacklist (const char *idcs)
 {
@@ -175,9 +202,6 @@ static void vstfx_un_blacklist (const char *idcs)
 	std::string bl;
 	vstfx_read_blacklist (bl);
 
-	::g_unlink (fn.c_str ());
-
-	assert (!Glib::file_test (fn, Glib::FILE_TEST_EXISTS));
 	assert (id.find ("\n") == string::npos);
 
 	id += "\n"; // add separator
@@ -185,17 +209,7 @@ static void vstfx_un_blacklist (const char *idcs)
 	if (rpl != string::npos) {
 		bl.replace (rpl, id.size (), "");
 	}
-	if (bl.empty ()) {
-		return;
-	}
-
-	FILE * blacklist_fd = NULL;
-	if (! (blacklist_fd = g_fopen (fn.c_str (), "w"))) {
-		PBD::error << _("Cannot open VST blacklist.") << endmsg;;
-		return;
-	}
-	fprintf (blacklist_fd, "%s", bl.c_str ());
-	::fclose (blacklist_fd);
+	vstfx_write_blacklist (bl);
 }
 
 /* return true if plugin is blacklisted */
@@ -222,6 +236,107 @@ static bool vst_is_blacklisted (const char *idcs)
 }
 
 
+#ifndef VST_SCANNER_APP
+
+/* *** VST Index *** */
+
+/* The index records size and modification time of every plugin at the time
+ * its .fsi cache file was written. A cache file is only used as long as the
+ * plugin still matches, so that replaced plugins are re-scanned even if the
+ * file's timestamp did not change. Plugins that are not yet indexed fall back
+ * to comparing timestamps of the plugin and its cache file.
+ */
+
+struct VSTIndexEntry {
+	int64_t mtime;
+	int64_t size;
+};
+
+typedef std::map<std::string, VSTIndexEntry> VSTIndex;
+
+static VSTIndex _vst_index;
+static bool     _vst_index_loaded = false;
+static bool     _vst_index_dirty = false;
+
+static string
+vstfx_index_path ()
+{
+	return Glib::build_filename (ARDOUR::user_cache_directory (), VST_INDEX);
+}
+
+/** parse the index, one "<mtime> <size> <path>" line per plugin */
+static void
+vstfx_load_index ()
+{
+	if (_vst_index_loaded) {
+		return;
+	}
+	_vst_index_loaded = true;
+
+	gchar* contents = NULL;
+	if (!g_file_get_contents (vstfx_index_path ().c_str (), &contents, NULL, NULL)) {
+		return;
+	}
+
+	char* line = contents;
+	while (line && *line) {
+		char* eol = strchr (line, '\n');
+		if (eol) {
+			*eol = '\0';
+		}
+
+		char* end;
+		VSTIndexEntry e;
+		e.mtime = g_ascii_strtoll (line, &end, 10);
+		if (end != line && *end == ' ') {
+			char* sz = end + 1;
+			e.size = g_ascii_strtoll (sz, &end, 10);
+			if (end != sz && *end == ' ' && end[1] != '\0') {
+				_vst_index[end + 1] = e;
+			}
+		}
+
+		line = eol ? eol + 1 : NULL;
+	}
+	g_free (contents);
+}
+
+/** @return 1 if the plugin matches its index entry, 0 if it was modified, -1 if it is not indexed */
+static int
+vstfx_index_lookup (const char* dllpath, GStatBuf const& dllstat)
+{
+	vstfx_load_index ();
+	VSTIndex::const_iterator i = _vst_index.find (dllpath);
+	if (i == _vst_index.end ()) {
+		return -1;
+	}
+	return (i->second.mtime == (int64_t) dllstat.st_mtime && i->second.size == (int64_t) dllstat.st_size) ? 1 : 0;
+}
+
+static void
+vstfx_index_add (const char* dllpath, GStatBuf const& dllstat)
+{
+	if (strchr (dllpath, '\n')) {
+		return;
+	}
+	vstfx_load_index ();
+	VSTIndexEntry e;
+	e.mtime = dllstat.st_mtime;
+	e.size  = dllstat.st_size;
+	_vst_index[dllpath] = e;
+	_vst_index_dirty = true;
+}
+
+static void
+vstfx_index_forget (const char* dllpath)
+{
+	vstfx_load_index ();
+	if (_vst_index.erase (dllpath) > 0) {
+		_vst_index_dirty = true;
+	}
+}
+
+#endif
 
 /* *** MEMORY MANAGEMENT *** */
 
@@ -446,10 +561,11 @@ vstfx_remove_infofile (const char *dllpath)
 	::g_unlink (vstfx_infofile_path (dllpath).c_str ());
 }
 
-/** cache file for given plugin
- * @return FILE of the .fsi cache if found and up-to-date*/
-static FILE *
-vstfx_infofile_for_read (const char* dllpath)
+/** check if the .fsi cache of a given plugin exists and is up-to-date
+ * @param verbose warn about outdated cache files
+ */
+static bool
+vstfx_infofile_valid (const char* dllpath, bool verbose)
 {
 	const size_t slen = strlen (dllpath);
 	if (
@@ -459,27 +575,58 @@ vstfx_infofile_for_read (const char* dllpath)
 			&&
 			(slen <= 4 || g_ascii_strcasecmp (&dllpath[slen-4], ".dll"))
 	   ) {
-		return 0;
+		return false;
 	}
 
 	string const path = vstfx_infofile_path (dllpath);
 
-	if (Glib::file_test (path, Glib::FileTest (Glib::FILE_TEST_EXISTS | Glib::FILE_TEST_IS_REGULAR))) {
-		GStatBuf dllstat;
-		GStatBuf fsistat;
+	if (!Glib::file_test (path, Glib::FileTest (Glib::FILE_TEST_EXISTS | Glib::FILE_TEST_IS_REGULAR))) {
+		return false;
+	}
 
-		if (g_stat (dllpath, &dllstat) == 0) {
-			if (g_stat (path.c_str (), &fsistat) == 0) {
-				if (dllstat.st_mtime <= fsistat.st_mtime) {
-					/* plugin is older than info file */
-					return g_fopen (path.c_str (), "rb");
+	GStatBuf dllstat;
+	GStatBuf fsistat;
+
+	if (g_stat (dllpath, &dllstat) == 0 && g_stat (path.c_str (), &fsistat) == 0) {
+#ifndef VST_SCANNER_APP
+		switch (vstfx_index_lookup (dllpath, dllstat)) {
+			case 1:
+				return true;
+			case 0:
+				if (verbose) {
+					PBD::warning << string_compose (_("Ignored VST plugin which was modified since it was scanned: '%1' (cache: '%2')"), dllpath, path) << endmsg;
+					PBD::info << _("Re-Scan Plugins (Preferences > Plugins) to update the cache.") << endmsg;
 				}
-			}
+				return false;
+			default:
+				break;
+		}
+#endif
+		if (dllstat.st_mtime <= fsistat.st_mtime) {
+			/* plugin is older than info file */
+#ifndef VST_SCANNER_APP
+			vstfx_index_add (dllpath, dllstat);
+#endif
+			return true;
 		}
+	}
+
+	if (verbose) {
 		PBD::warning << string_compose (_("Ignored VST plugin which is newer than cache: '%1' (cache: '%2')"), dllpath, path) << endmsg;
 		PBD::info << _("Re-Scan Plugins (Preferences > Plugins) to update the cache, also make sure your system-time is set correctly.") << endmsg;
 	}
-	return NULL;
+	return false;
+}
+
+/** cache file for given plugin
+ * @return FILE of the .fsi cache if found and up-to-date*/
+static FILE *
+vstfx_infofile_for_read (const char* dllpath)
+{
+	if (!vstfx_infofile_valid (dllpath, true)) {
+		return NULL;
+	}
+	return g_fopen (vstfx_infofile_path (dllpath).c_str (), "rb");
 }
 
 /** newly created cache file for given plugin
@@ -961,6 +1108,11 @@ close_error_log () {
 	_errorlog_dll = 0;
 }
 
+static void parse_parallel_scanner_output (std::string dllpath, std::string msg, size_t /*len*/)
+{
+	PBD::error << "VST '" << dllpath << "': " << msg;
+}
+
 #endif
 
 
@@ -987,7 +1139,12 @@ vstfx_get_info (const char* dllpath, enum ARDOUR::PluginType type, enum VSTScanM
 		/* never scan explicitly, use cache only */
 		return infos;
 	}
-	else if (mode == VST_SCAN_USE_APP && scanner_bin_path != "") {
+
+	/* discard outdated cache, the scanner app would otherwise use it */
+	vstfx_remove_infofile (dllpath);
+	vstfx_index_forget (dllpath);
+
+	if (mode == VST_SCAN_USE_APP && scanner_bin_path != "") {
 		/* use external scanner app */
 
 		char **argp= (char**) calloc (3,sizeof (char*));
@@ -1135,6 +1292,173 @@ vstfx_get_info_fst (char* dllpath, enum VSTScanMode mode)
 }
 #endif
 
+#ifndef VST_SCANNER_APP
+namespace {
+/** a scanner process of vstfx_scan_parallel() */
+struct ParallelScan {
+	ParallelScan (std::string const& bin, char** argp, std::string const& path)
+		: scanner (bin, argp)
+		, dllpath (path)
+		, timeout (PLUGIN_SCAN_TIMEOUT)
+	{}
+
+	ARDOUR::SystemExec        scanner;
+	std::string               dllpath;
+	int                       timeout;
+	PBD::ScopedConnectionList cons;
+};
+}
+
+/** Run the external scanner app for all plugins in @param dllpaths which are
+ * neither blacklisted nor cached, using up to Config->get_vst_scan_jobs()
+ * concurrent processes, each with its own timeout.
+ *
+ * This only populates the cache and the blacklist, plugins are subsequently
+ * discovered from the cache. Scanner processes may race when updating the
+ * blacklist, so it is re-written once all of them have finished.
+ */
+void
+vstfx_scan_parallel (std::vector<std::string> const& dllpaths)
+{
+	std::string scanner_bin_path = ARDOUR::PluginManager::scanner_bin_path;
+	uint32_t jobs = Config->get_vst_scan_jobs ();
+
+	if (jobs == 0) {
+		jobs = hardware_concurrency ();
+	}
+
+	if (scanner_bin_path.empty () || jobs < 2) {
+		return;
+	}
+
+	vector<string> todo;
+	for (vector<string>::const_iterator i = dllpaths.begin (); i != dllpaths.end (); ++i) {
+		if (!vst_is_blacklisted (i->c_str ()) && !vstfx_infofile_valid (i->c_str (), false)) {
+			todo.push_back (*i);
+		}
+	}
+
+	if (todo.size () < 2) {
+		/* nothing to gain, leave it to vstfx_get_info() */
+		return;
+	}
+
+	std::string blacklist;
+	vstfx_read_blacklist (blacklist);
+
+	std::list<ParallelScan*> running;
+	vector<string>           failed;
+	vector<string>::const_iterator next = todo.begin ();
+	bool cancelled = false;
+	int  tick = 0;
+
+	while (next != todo.end () || !running.empty ()) {
+
+		while (!cancelled && next != todo.end () && running.size () < jobs) {
+			std::string const& dllpath (*next++);
+
+			vstfx_remove_infofile (dllpath.c_str ());
+			vstfx_index_forget (dllpath.c_str ());
+
+			char **argp= (char**) calloc (3,sizeof (char*));
+			argp[0] = strdup (scanner_bin_path.c_str ());
+			argp[1] = strdup (dllpath.c_str ());
+			argp[2] = 0;
+
+			ParallelScan* ps = new ParallelScan (scanner_bin_path, argp, dllpath);
+			ps->scanner.ReadStdout.connect_same_thread (ps->cons, boost::bind (&parse_parallel_scanner_output, dllpath, _1 ,_2));
+
+			ARDOUR::PluginScanMessage (_("VST"), dllpath, true);
+
+			if (ps->scanner.start (ARDOUR::SystemExec::MergeWithStdin)) {
+				PBD::error << string_compose (_("Cannot launch VST scanner app '%1': %2"), scanner_bin_path, strerror (errno)) << endmsg;
+				delete ps;
+				/* let vstfx_get_info() handle the remaining ones */
+				next = todo.end ();
+				break;
+			}
+			running.push_back (ps);
+		}
+
+		ARDOUR::GUIIdle ();
+		Glib::usleep (100000);
+
+		cancelled = cancelled || ARDOUR::PluginManager::instance ().cancelled ();
+		const bool no_timeout = ARDOUR::PluginManager::instance ().no_timeout ();
+		int remain = 0;
+
+		for (std::list<ParallelScan*>::iterator i = running.begin (); i != running.end ();) {
+			ParallelScan* ps = *i;
+			bool done = cancelled || !ps->scanner.is_running ();
+
+			if (!done && ps->timeout > 0 && !no_timeout) {
+				if (--ps->timeout == 0) {
+					PBD::warning << string_compose (_("VST scanner timed out: '%1'"), ps->dllpath) << endmsg;
+					done = true;
+				}
+			}
+
+			if (!done) {
+				remain = std::max (remain, ps->timeout);
+				++i;
+				continue;
+			}
+
+			ps->scanner.terminate ();
+
+			if (cancelled) {
+				// remove info file (might be incomplete)
+				vstfx_remove_infofile (ps->dllpath.c_str ());
+			} else if (!vstfx_infofile_valid (ps->dllpath.c_str (), false)) {
+				failed.push_back (ps->dllpath);
+			}
+
+			delete ps;
+			i = running.erase (i);
+		}
+
+		if (remain > 0 && (tick++ % 5) == 0) {
+			ARDOUR::PluginScanTimeout (remain);
+		}
+	}
+
+	/* restore the blacklist and add plugins which failed to scan */
+	for (vector<string>::const_iterator i = failed.begin (); i != failed.end (); ++i) {
+		vstfx_remove_infofile (i->c_str ());
+		blacklist += *i + "\n";
+	}
+	vstfx_write_blacklist (blacklist);
+}
+
+void
+vstfx_save_index ()
+{
+	if (!_vst_index_dirty) {
+		return;
+	}
+
+	string const fn  = vstfx_index_path ();
+	string const tmp = fn + ".tmp";
+
+	FILE* fp = g_fopen (tmp.c_str (), "w");
+	if (!fp) {
+		PBD::error << string_compose (_("Cannot write VST index '%1'"), fn) << endmsg;
+		return;
+	}
+
+	for (VSTIndex::const_iterator i = _vst_index.begin (); i != _vst_index.end (); ++i) {
+		fprintf (fp, "%" PRId64 " %" PRId64 " %s\n", i->second.mtime, i->second.size, i->first.c_str ());
+	}
+
+	if (::fclose (fp) || ::g_rename (tmp.c_str (), fn.c_str ())) {
+		::g_unlink (tmp.c_str ());
+		PBD::error << string_compose (_("Cannot write VST index '%1'"), fn) << endmsg;
+		return;
+	}
+	_vst_index_dirty = false;
+}
+#endif
+
 #ifndef VST_SCANNER_APP
 } // namespace
 #endif
@@ -655,6 +655,17 @@ VSTPlugin::plugin_latency () const
 #endif
 }
 
+samplecnt_t
+VSTPlugin::signal_tail () const
+{
+	/* 0: not supported, 1: no tail */
+	const intptr_t tail = _plugin->dispatcher (_plugin, effGetTailSize, 0, 0, NULL, 0.0f);
+	if (tail <= 0) {
+		return -1;
+	}
+	return tail == 1 ? 0 : tail;
+}
+
 set<Evoral::Parameter>
 VSTPlugin::automatable () const
 {
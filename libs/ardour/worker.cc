@@ -20,72 +20,220 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <glibmm/timer.h>
 
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/compose.h"
 #include "pbd/pthread_utils.h"
 
+#include "ardour/rc_configuration.h"
 #include "ardour/worker.h"
 
+/* Messages in the request and response rings are
+ *   uint32_t size, int64_t schedule-time, uint8_t data[size - sizeof (int64_t)]
+ */
+
 namespace ARDOUR {
 
+/**
+   Threads which execute the requests of all threaded workers, one request
+   of one worker at a time, visiting the workers round-robin.
+*/
+class WorkerPool
+{
+public:
+	static WorkerPool* instance() { return _instance; }
+	static WorkerPool* create();
+
+	void add(Worker*);
+	void remove(Worker*);
+	void signal() { _sem.signal(); }
+	DSPStats stats();
+
+private:
+	WorkerPool();
+	void run();
+	Worker* claim();
+
+	static WorkerPool*          _instance;
+	static Glib::Threads::Mutex _instance_lock;
+
+	Glib::Threads::Mutex _lock;
+	std::vector<Worker*> _workers;
+	size_t               _next;
+	PBD::Semaphore       _sem;
+};
+
+WorkerPool*          WorkerPool::_instance = 0;
+Glib::Threads::Mutex WorkerPool::_instance_lock;
+
+WorkerPool*
+WorkerPool::create()
+{
+	Glib::Threads::Mutex::Lock lm(_instance_lock);
+	if (!_instance) {
+		_instance = new WorkerPool();
+	}
+	return _instance;
+}
+
+WorkerPool::WorkerPool()
+	: _next(0)
+	, _sem("worker_pool_semaphore", 0)
+{
+	uint32_t n_threads = Config->get_lv2_worker_threads();
+	if (n_threads == 0) {
+		n_threads = hardware_concurrency();
+	}
+	for (uint32_t n = 0; n < std::max(1U, n_threads); ++n) {
+		Glib::Threads::Thread::create(sigc::mem_fun(*this, &WorkerPool::run));
+	}
+}
+
+void
+WorkerPool::add(Worker* w)
+{
+	Glib::Threads::Mutex::Lock lm(_lock);
+	_workers.push_back(w);
+}
+
+void
+WorkerPool::remove(Worker* w)
+{
+	{
+		Glib::Threads::Mutex::Lock lm(_lock);
+		std::vector<Worker*>::iterator i = std::find(_workers.begin(), _workers.end(), w);
+		if (i != _workers.end()) {
+			_workers.erase(i);
+		}
+		_next = 0;
+	}
+	/* a request may still be in progress */
+	while (g_atomic_int_get(&w->_busy)) {
+		Glib::usleep(1000);
+	}
+}
+
+DSPStats
+WorkerPool::stats()
+{
+	DSPStats s;
+	Glib::Threads::Mutex::Lock lm(_lock);
+	for (std::vector<Worker*>::const_iterator i = _workers.begin(); i != _workers.end(); ++i) {
+		s.merge((*i)->latency_stats());
+	}
+	return s;
+}
+
+Worker*
+WorkerPool::claim()
+{
+	Glib::Threads::Mutex::Lock lm(_lock);
+	const size_t n_workers = _workers.size();
+	for (size_t n = 0; n < n_workers; ++n) {
+		Worker* w = _workers[(_next + n) % n_workers];
+		if (w->has_request() && g_atomic_int_compare_and_exchange(&w->_busy, 0, 1)) {
+			_next = (_next + n + 1) % n_workers;
+			return w;
+		}
+	}
+	return 0;
+}
+
+void
+WorkerPool::run()
+{
+	pthread_set_name ("LV2Worker");
+
+	while (true) {
+		_sem.wait();
+
+		Worker* w;
+		while ((w = claim())) {
+			w->process_request();
+			g_atomic_int_set(&w->_busy, 0);
+		}
+	}
+}
+
 Worker::Worker(Workee* workee, uint32_t ring_size, bool threaded)
 	: _workee(workee)
 	, _requests(threaded ? new PBD::RingBuffer<uint8_t>(ring_size) : NULL)
 	, _responses(new PBD::RingBuffer<uint8_t>(ring_size))
 	, _response((uint8_t*)malloc(ring_size))
-	, _sem(string_compose ("worker_semaphore%1", this).c_str(), 0)
-	, _thread(NULL)
-	, _exit(false)
+	, _request(NULL)
+	, _request_size(0)
+	, _request_time(0)
+	, _busy(0)
 	, _synchronous(!threaded)
 {
 	if (threaded) {
-		_thread = Glib::Threads::Thread::create(
-			sigc::mem_fun(*this, &Worker::run));
+		WorkerPool::create()->add(this);
 	}
 }
 
 Worker::~Worker()
 {
-	_exit = true;
-	_sem.signal();
-	if (_thread) {
-		_thread->join();
+	if (_requests) {
+		WorkerPool::instance()->remove(this);
 	}
 	delete _responses;
 	delete _requests;
 	free (_response);
+	free (_request);
+}
+
+DSPStats
+Worker::pool_stats()
+{
+	WorkerPool* pool = WorkerPool::instance();
+	return pool ? pool->stats() : DSPStats();
 }
 
 bool
 Worker::schedule(uint32_t size, const void* data)
 {
+	const int64_t now = g_get_monotonic_time();
+
 	if (_synchronous || !_requests) {
+		_request_time = now;
 		_workee->work(*this, size, data);
 		emit_responses ();
 		return true;
 	}
-	if (_requests->write_space() < size + sizeof(size)) {
+
+	const uint32_t total = size + sizeof(now);
+	if (_requests->write_space() < total + sizeof(total)) {
+		return false;
+	}
+	if (_requests->write((const uint8_t*)&total, sizeof(total)) != sizeof(total)) {
 		return false;
 	}
-	if (_requests->write((const uint8_t*)&size, sizeof(size)) != sizeof(size)) {
+	if (_requests->write((const uint8_t*)&now, sizeof(now)) != sizeof(now)) {
 		return false;
 	}
 	if (_requests->write((const uint8_t*)data, size) != size) {
 		return false;
 	}
-	_sem.signal();
+	WorkerPool::instance()->signal();
 	return true;
 }
 
 bool
 Worker::respond(uint32_t size, const void* data)
 {
-	if (_responses->write_space() < size + sizeof(size)) {
+	const uint32_t total = size + sizeof(_request_time);
+	if (_responses->write_space() < total + sizeof(total)) {
 		return false;
 	}
-	if (_responses->write((const uint8_t*)&size, sizeof(size)) != sizeof(size)) {
+	if (_responses->write((const uint8_t*)&total, sizeof(total)) != sizeof(total)) {
+		return false;
+	}
+	if (_responses->write((const uint8_t*)&_request_time, sizeof(_request_time)) != sizeof(_request_time)) {
 		return false;
 	}
 	if (_responses->write((const uint8_t*)data, size) != size) {
@@ -122,6 +270,7 @@ Worker::emit_responses()
 {
 	uint32_t read_space = _responses->read_space();
 	uint32_t size       = 0;
+	int64_t  scheduled;
 	while (read_space >= sizeof(size)) {
 		if (!verify_message_completeness(_responses)) {
 			/* message from writer is yet incomplete. respond next cycle */
@@ -130,62 +279,53 @@ Worker::emit_responses()
 		/* read and send response */
 		_responses->read((uint8_t*)&size, sizeof(size));
 		_responses->read(_response, size);
-		_workee->work_response(size, _response);
+		memcpy (&scheduled, _response, sizeof(scheduled));
+		_latency.add(g_get_monotonic_time() - scheduled);
+		_workee->work_response(size - sizeof(scheduled), _response + sizeof(scheduled));
 		read_space -= sizeof(size) + size;
 	}
 }
 
-void
-Worker::run()
+bool
+Worker::has_request()
 {
-	pthread_set_name ("LV2Worker");
-
-	void*  buf      = NULL;
-	size_t buf_size = 0;
-	while (true) {
-		_sem.wait();
-		if (_exit) {
-			free(buf);
-			return;
-		}
+	return _requests->read_space() >= sizeof(uint32_t) && verify_message_completeness(_requests);
+}
 
-		uint32_t size = _requests->read_space();
-		if (size < sizeof(size)) {
-			PBD::error << "Worker: no work-data on ring buffer" << endmsg;
-			continue;
-		}
-		while (!verify_message_completeness(_requests)) {
-			Glib::usleep(2000);
-			if (_exit) {
-				if (buf) free(buf);
-				return;
-			}
-		}
-		if (_requests->read((uint8_t*)&size, sizeof(size)) < sizeof(size)) {
-			PBD::error << "Worker: Error reading size from request ring"
-			           << endmsg;
-			continue;
-		}
+void
+Worker::process_request()
+{
+	/* another pool thread may have taken it meanwhile */
+	if (!has_request()) {
+		return;
+	}
 
-		if (size > buf_size) {
-			buf = realloc(buf, size);
-			if (buf) {
-				buf_size = size;
-			} else {
-				PBD::fatal << "Worker: Error allocating memory" << endmsg;
-				abort(); /*NOTREACHED*/
-			}
-		}
-		assert (buf);
+	uint32_t size;
+	if (_requests->read((uint8_t*)&size, sizeof(size)) < sizeof(size)) {
+		PBD::error << "Worker: Error reading size from request ring"
+		           << endmsg;
+		return;
+	}
 
-		if (_requests->read((uint8_t*)buf, size) < size) {
-			PBD::error << "Worker: Error reading body from request ring"
-			           << endmsg;
-			continue;  // TODO: This is probably fatal
+	if (size > _request_size) {
+		_request = (uint8_t*)realloc(_request, size);
+		if (_request) {
+			_request_size = size;
+		} else {
+			PBD::fatal << "Worker: Error allocating memory" << endmsg;
+			abort(); /*NOTREACHED*/
 		}
+	}
+	assert (_request);
 
-		_workee->work(*this, size, buf);
+	if (_requests->read(_request, size) < size) {
+		PBD::error << "Worker: Error reading body from request ring"
+		           << endmsg;
+		return;  // TODO: This is probably fatal
 	}
+
+	memcpy (&_request_time, _request, sizeof(_request_time));
+	_workee->work(*this, size - sizeof(_request_time), _request + sizeof(_request_time));
 }
 
 } // namespace ARDOUR
@@ -26,8 +26,10 @@
  *  @brief Implementation of the main canvas classes.
  */
 
-#include <list>
 #include <cassert>
+#include <cmath>
+#include <list>
+#include <vector>
 #include <gtkmm/adjustment.h>
 #include <gtkmm/label.h>
 #include <gtkmm/window.h>
@@ -411,6 +413,7 @@ Canvas::item_moved (Item* item, Rect pre_change_parent_bounding_box)
 void
 Canvas::queue_draw_item_area (Item* item, Rect area)
 {
+	item->invalidate_render_caches ();
 	request_redraw (item->item_to_window (area));
 }
 
@@ -451,6 +454,7 @@ GtkCanvas::GtkCanvas ()
 	, current_tooltip_item (0)
 	, tooltip_window (0)
 	, _in_dtor (false)
+	, _batch_damage (true)
 	, _nsglview (0)
 {
 #ifdef USE_CAIRO_IMAGE_SURFACE /* usually Windows builds */
@@ -458,6 +462,7 @@ GtkCanvas::GtkCanvas ()
 #else
 	_use_image_surface = NULL != g_getenv("ARDOUR_IMAGE_SURFACE");
 #endif
+	_batch_damage = NULL == g_getenv("ARDOUR_NO_DAMAGE_BATCHING");
 
 	/* these are the events we want to know about */
 	add_events (Gdk::BUTTON_PRESS_MASK | Gdk::BUTTON_RELEASE_MASK | Gdk::POINTER_MOTION_MASK |
@@ -1192,6 +1197,8 @@ void
 GtkCanvas::on_unmap ()
 {
 	stop_tooltip_timeout ();
+	damage_connection.disconnect ();
+	_damage.clear ();
 	Gtk::EventBox::on_unmap();
 #ifdef __APPLE__
 	if (_nsglview) {
@@ -1203,6 +1210,10 @@ GtkCanvas::on_unmap ()
 void
 GtkCanvas::queue_draw()
 {
+	/* everything is redrawn, pending damage is moot */
+	damage_connection.disconnect ();
+	_damage.clear ();
+
 #ifdef __APPLE__
 	if (_nsglview) {
 		Gtkmm2ext::nsglview_queue_draw (_nsglview, 0, 0, get_width (), get_height ());
@@ -1241,7 +1252,11 @@ GtkCanvas::request_redraw (Rect const & request)
 	if (real_area) {
 		if (real_area.width () && real_area.height ()) {
 			// Item intersects with visible canvas area
-			queue_draw_area (real_area.x0, real_area.y0, real_area.width(), real_area.height());
+			if (_batch_damage) {
+				add_damage (real_area);
+			} else {
+				queue_draw_area (real_area.x0, real_area.y0, real_area.width(), real_area.height());
+			}
 		}
 
 	} else {
@@ -1249,6 +1264,83 @@ GtkCanvas::request_redraw (Rect const & request)
 	}
 }
 
+/* merge two damage rectangles if their union is not more than this much
+ * larger than the sum of their areas
+ */
+static const double damage_merge_slack = 1.25;
+/* above this many disjoint rectangles, redraw their union */
+static const size_t max_damage_rects = 16;
+
+static inline double
+rect_area (Rect const & r)
+{
+	return r.width () * r.height ();
+}
+
+/** Add an area (in window coordinates) to the damage of the current frame.
+ *
+ *  Rather than passing every single item's damage on to GDK, overlapping
+ *  (or nearly adjacent) rectangles are merged as long as the union does
+ *  not cover much more than the rectangles themselves. The result is
+ *  handed to GDK once per main loop iteration, by flush_damage().
+ */
+void
+GtkCanvas::add_damage (Rect const & area)
+{
+	Rect r = area;
+
+	/* merging a rectangle may make it overlap with one we already
+	 * checked, so repeat until nothing more can be merged.
+	 */
+	bool merged;
+	do {
+		merged = false;
+		for (std::vector<Rect>::iterator i = _damage.begin(); i != _damage.end(); ++i) {
+			Rect const u = i->extend (r);
+			if (rect_area (u) <= (rect_area (*i) + rect_area (r)) * damage_merge_slack) {
+				r = u;
+				_damage.erase (i);
+				merged = true;
+				break;
+			}
+		}
+	} while (merged);
+
+	_damage.push_back (r);
+
+	if (_damage.size () > max_damage_rects) {
+		/* too fragmented, just redraw the union */
+		Rect u = _damage.front ();
+		for (std::vector<Rect>::const_iterator i = _damage.begin(); i != _damage.end(); ++i) {
+			u = u.extend (*i);
+		}
+		_damage.clear ();
+		_damage.push_back (u);
+	}
+
+	if (!damage_connection.connected ()) {
+		/* run before GDK processes its own redraw queue */
+		damage_connection = Glib::signal_idle().connect (sigc::mem_fun (*this, &GtkCanvas::flush_damage), GDK_PRIORITY_REDRAW - 10);
+	}
+}
+
+bool
+GtkCanvas::flush_damage ()
+{
+	std::vector<Rect> damage;
+	damage.swap (_damage);
+
+	if (_in_dtor || !is_mapped ()) {
+		return false;
+	}
+
+	for (std::vector<Rect>::const_iterator i = damage.begin(); i != damage.end(); ++i) {
+		queue_draw_area (floor (i->x0), floor (i->y0), ceil (i->width ()), ceil (i->height ()));
+	}
+
+	return false; /* one-shot */
+}
+
 /** Called to request that we try to get a particular size for ourselves.
  *  @param size Size to request, in pixels.
  */
@@ -28,6 +28,7 @@
 #define __CANVAS_CANVAS_H__
 
 #include <set>
+#include <vector>
 
 #include <gtkmm/alignment.h>
 #include <gtkmm/eventbox.h>
@@ -200,7 +201,7 @@ class LIBCANVAS_API GtkCanvas : public Canvas, public Gtk::EventBox, public Gtkm
 {
 public:
 	GtkCanvas ();
-	~GtkCanvas () { _in_dtor = true ; }
+	~GtkCanvas () { _in_dtor = true ; damage_connection.disconnect (); }
 
 	void use_nsglview ();
 
@@ -291,6 +292,13 @@ private:
 
 	bool _in_dtor;
 
+	/* per-frame damage accumulator, see add_damage() */
+	bool _batch_damage;
+	std::vector<Rect> _damage;
+	sigc::connection damage_connection;
+	void add_damage (Rect const &);
+	bool flush_damage ();
+
 	void* _nsglview;
 	Cairo::RefPtr<Cairo::Surface> _canvas_image;
 };
@@ -20,6 +20,8 @@
 #ifndef __CANVAS_CONTAINER_H__
 #define __CANVAS_CONTAINER_H__
 
+#include <cairomm/surface.h>
+
 #include "canvas/item.h"
 
 namespace ArdourCanvas
@@ -59,6 +61,26 @@ public:
 	 * overridden as necessary.
 	 */
 	void prepare_for_render (Rect const & area) const;
+
+	/** Keep a retained (image surface) rendering of all children,
+	 *  and blit from it instead of re-rendering them on every expose.
+	 *
+	 *  This is only worthwhile for subtrees that rarely change (track
+	 *  backgrounds, grid lines etc). Any change to a descendant
+	 *  discards the cached surface, as does scrolling or resizing
+	 *  the part of the container that is visible in the window.
+	 */
+	void set_render_cache (bool yn);
+	bool render_cache () const { return _render_cache_enabled; }
+
+	void invalidate_render_cache () const;
+
+private:
+	bool _render_cache_enabled;
+	mutable bool _render_cache_valid;
+	/** area covered by _render_cache, in window coordinates */
+	mutable Rect _render_cache_area;
+	mutable Cairo::RefPtr<Cairo::ImageSurface> _render_cache;
 };
 
 }
@@ -22,6 +22,7 @@
 namespace ArdourCanvas {
 	class Line;
 	class LineSet;
+	class NoteSet;
 	class Rectangle;
 	class Ruler;
 	class Polygon;
@@ -31,6 +32,7 @@ namespace ArdourCanvas {
 	class Text;
 	class Curve;
 	class ScrollGroup;
+	struct Rect;
 }
 
 #endif /* __canvas_canvas_fwd_h__ */
@@ -82,6 +82,17 @@ public:
 	 */
 	virtual void prepare_for_render (Rect const & area) const { }
 
+	/** Discard any retained rendering this item holds of itself or
+	 *  its children. The default implementation does nothing; see
+	 *  Container::set_render_cache().
+	 */
+	virtual void invalidate_render_cache () const { }
+
+	/** Call invalidate_render_cache() on this item and all of its
+	 *  ancestors, because some part of it needs to be redrawn.
+	 */
+	void invalidate_render_caches () const;
+
 	/** Adds one or more items to the vector \p items based on their
 	 * covering \p point which is in window coordinates
 	 *
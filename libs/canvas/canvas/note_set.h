@@ -0,0 +1,90 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __CANVAS_NOTESET_H__
+#define __CANVAS_NOTESET_H__
+
+#include <vector>
+
+#include "canvas/item.h"
+#include "canvas/visibility.h"
+
+namespace ArdourCanvas {
+
+/** A single item that draws a (potentially very large) number of
+ *  rectangular notes from a compact array.
+ *
+ *  Notes are kept sorted by their start (x0), together with the running
+ *  maximum of their ends (x1), so that both rendering and hit-testing
+ *  only need a binary search plus a scan over the notes that actually
+ *  overlap the area of interest.
+ *
+ *  Each note carries an opaque index, which the owner can use to map it
+ *  back to whatever model object it represents.
+ */
+class LIBCANVAS_API NoteSet : public Item
+{
+public:
+	NoteSet (Canvas*);
+	NoteSet (Item*);
+
+	struct Note {
+		Note (Rect const & r, Gtkmm2ext::Color fill_, Gtkmm2ext::Color outline_, uint32_t index_)
+			: rect (r), fill (fill_), outline (outline_), index (index_) {}
+
+		/** in item coordinates */
+		Rect rect;
+		Gtkmm2ext::Color fill;
+		Gtkmm2ext::Color outline;
+		uint32_t index;
+	};
+
+	typedef std::vector<Note> Notes;
+
+	void compute_bounding_box () const;
+	void render (Rect const & area, Cairo::RefPtr<Cairo::Context>) const;
+
+	bool covers (Duple const &) const;
+
+	/** Replace all notes with \p notes (which is left empty) */
+	void set (Notes& notes);
+	void clear ();
+
+	/** Change the colors of all notes, \p fill and \p outline are indexed by Note::index */
+	void set_colors (std::vector<Gtkmm2ext::Color> const & fill, std::vector<Gtkmm2ext::Color> const & outline);
+
+	bool empty () const { return _notes.empty (); }
+	size_t size () const { return _notes.size (); }
+
+	/** @param point Point in item coordinates.
+	 *  @return index of the topmost note covering \p point, or -1.
+	 */
+	int32_t note_at (Duple const & point) const;
+
+	/** Append the indices of all notes intersecting \p r (in item coordinates) */
+	void notes_in (Rect const & r, std::vector<uint32_t>& indices) const;
+
+private:
+	Notes _notes;
+	/** _max_x1[n] is the largest x1 of _notes[0] ... _notes[n] */
+	std::vector<Coord> _max_x1;
+
+	Notes::size_type first_ending_after (Coord x) const;
+};
+
+}
+
+#endif /* __CANVAS_NOTESET_H__ */
@@ -17,23 +17,32 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cmath>
+
+#include "canvas/canvas.h"
 #include "canvas/container.h"
 
 using namespace ArdourCanvas;
 
 Container::Container (Canvas* canvas)
 	: Item (canvas)
+	, _render_cache_enabled (false)
+	, _render_cache_valid (false)
 {
 }
 
 Container::Container (Item* parent)
 	: Item (parent)
+	, _render_cache_enabled (false)
+	, _render_cache_valid (false)
 {
 }
 
 
 Container::Container (Item* parent, Duple const & p)
 	: Item (parent, p)
+	, _render_cache_enabled (false)
+	, _render_cache_valid (false)
 {
 }
 
@@ -46,7 +55,76 @@ Container::prepare_for_render (Rect const & area) const
 void
 Container::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) const
 {
-	Item::render_children (area, context);
+	if (!_render_cache_enabled) {
+		Item::render_children (area, context);
+		return;
+	}
+
+	Rect bbox = bounding_box ();
+
+	if (!bbox) {
+		return;
+	}
+
+	/* cache only what is currently visible, aligned to whole pixels */
+
+	Rect visible = item_to_window (bbox, false).intersection (_canvas->visible_area ());
+
+	if (!visible || visible.width () < 1 || visible.height () < 1) {
+		return;
+	}
+
+	Rect const cache_area (floor (visible.x0), floor (visible.y0), ceil (visible.x1), ceil (visible.y1));
+
+	if (!_render_cache || cache_area != _render_cache_area) {
+		_render_cache = Cairo::ImageSurface::create (Cairo::FORMAT_ARGB32, (int) cache_area.width (), (int) cache_area.height ());
+		_render_cache_area = cache_area;
+		_render_cache_valid = false;
+	}
+
+	if (!_render_cache_valid) {
+		Cairo::RefPtr<Cairo::Context> cache_context = Cairo::Context::create (_render_cache);
+		cache_context->set_operator (Cairo::OPERATOR_CLEAR);
+		cache_context->paint ();
+		cache_context->set_operator (Cairo::OPERATOR_OVER);
+		cache_context->translate (-cache_area.x0, -cache_area.y0);
+		Item::render_children (cache_area, cache_context);
+		_render_cache->flush ();
+		_render_cache_valid = true;
+	}
+
+	Rect draw = area.intersection (cache_area);
+
+	if (!draw) {
+		return;
+	}
+
+	context->save ();
+	context->rectangle (draw.x0, draw.y0, draw.width (), draw.height ());
+	context->clip ();
+	context->set_source (_render_cache, cache_area.x0, cache_area.y0);
+	context->paint ();
+	context->restore ();
+}
+
+void
+Container::set_render_cache (bool yn)
+{
+	if (_render_cache_enabled == yn) {
+		return;
+	}
+
+	_render_cache_enabled = yn;
+	_render_cache_valid = false;
+	_render_cache.clear ();
+
+	redraw ();
+}
+
+void
+Container::invalidate_render_cache () const
+{
+	_render_cache_valid = false;
 }
 
 void
@@ -623,10 +623,19 @@ void
 Item::redraw () const
 {
 	if (visible() && _bounding_box && _canvas) {
+		invalidate_render_caches ();
 		_canvas->request_redraw (item_to_window (_bounding_box));
 	}
 }
 
+void
+Item::invalidate_render_caches () const
+{
+	for (Item const * i = this; i; i = i->parent ()) {
+		i->invalidate_render_cache ();
+	}
+}
+
 void
 Item::begin_change ()
 {
@@ -1058,6 +1067,9 @@ Item::invalidate_lut () const
 {
 	delete _lut;
 	_lut = 0;
+
+	/* the set or stacking order of our children changed */
+	invalidate_render_caches ();
 }
 
 void
@@ -0,0 +1,197 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "gtkmm2ext/colors.h"
+
+#include "canvas/note_set.h"
+
+using namespace std;
+using namespace ArdourCanvas;
+
+class NoteStartSorter {
+public:
+	bool operator() (NoteSet::Note const & a, NoteSet::Note const & b) {
+		return a.rect.x0 < b.rect.x0;
+	}
+};
+
+NoteSet::NoteSet (Canvas* c)
+	: Item (c)
+{
+}
+
+NoteSet::NoteSet (Item* parent)
+	: Item (parent)
+{
+}
+
+void
+NoteSet::compute_bounding_box () const
+{
+	if (_notes.empty ()) {
+		_bounding_box = Rect ();
+	} else {
+		Rect bbox = _notes.front().rect;
+		for (Notes::const_iterator i = _notes.begin(); i != _notes.end(); ++i) {
+			bbox = bbox.extend (i->rect);
+		}
+		_bounding_box = bbox;
+	}
+
+	_bounding_box_dirty = false;
+}
+
+NoteSet::Notes::size_type
+NoteSet::first_ending_after (Coord x) const
+{
+	/* _max_x1 is non-decreasing, so every note before the returned
+	 * index ends before x.
+	 */
+	return lower_bound (_max_x1.begin(), _max_x1.end(), x) - _max_x1.begin();
+}
+
+void
+NoteSet::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) const
+{
+	if (_notes.empty ()) {
+		return;
+	}
+
+	/* area is in window coordinates; do the search in item coordinates
+	 * and translate each note by a single offset, rather than walking
+	 * the parent chain (item_to_window()) for every note.
+	 */
+
+	Rect const a = window_to_item (area);
+	Duple const offset = item_to_window (Duple (0, 0), false);
+
+	context->set_line_width (1.0);
+
+	for (Notes::size_type n = first_ending_after (a.x0); n < _notes.size() && _notes[n].rect.x0 < a.x1; ++n) {
+
+		Note const & note (_notes[n]);
+
+		if (note.rect.y1 < a.y0 || note.rect.y0 >= a.y1 || note.rect.x1 < a.x0) {
+			continue;
+		}
+
+		Rect const self = note.rect.translate (offset);
+
+		/* same pixel alignment as Rectangle::render() */
+		const double x0 = round (self.x0);
+		const double y0 = round (self.y0);
+		const double w  = max (1.0, round (self.x1) - x0);
+		const double h  = max (1.0, round (self.y1) - y0);
+
+		Gtkmm2ext::set_source_rgba (context, note.fill);
+		context->rectangle (x0, y0, w, h);
+		context->fill ();
+
+		if (w > 2 && h > 2) {
+			Gtkmm2ext::set_source_rgba (context, note.outline);
+			context->rectangle (x0 + 0.5, y0 + 0.5, w - 1.0, h - 1.0);
+			context->stroke ();
+		}
+	}
+}
+
+void
+NoteSet::set (Notes& notes)
+{
+	begin_change ();
+
+	_notes.swap (notes);
+	notes.clear ();
+
+	stable_sort (_notes.begin(), _notes.end(), NoteStartSorter());
+
+	_max_x1.clear ();
+	_max_x1.reserve (_notes.size());
+
+	Coord m = -COORD_MAX;
+	for (Notes::const_iterator i = _notes.begin(); i != _notes.end(); ++i) {
+		m = max (m, i->rect.x1);
+		_max_x1.push_back (m);
+	}
+
+	_bounding_box_dirty = true;
+	end_change ();
+}
+
+void
+NoteSet::clear ()
+{
+	if (_notes.empty ()) {
+		return;
+	}
+
+	begin_change ();
+	_notes.clear ();
+	_max_x1.clear ();
+	_bounding_box_dirty = true;
+	end_change ();
+}
+
+void
+NoteSet::set_colors (std::vector<Gtkmm2ext::Color> const & fill, std::vector<Gtkmm2ext::Color> const & outline)
+{
+	for (Notes::iterator i = _notes.begin(); i != _notes.end(); ++i) {
+		if (i->index < fill.size() && i->index < outline.size()) {
+			i->fill    = fill[i->index];
+			i->outline = outline[i->index];
+		}
+	}
+
+	redraw ();
+}
+
+int32_t
+NoteSet::note_at (Duple const & point) const
+{
+	int32_t found = -1;
+
+	/* later notes are drawn on top, so keep the last match */
+
+	for (Notes::size_type n = first_ending_after (point.x); n < _notes.size() && _notes[n].rect.x0 <= point.x; ++n) {
+		Rect const & r (_notes[n].rect);
+		if (point.x <= r.x1 && point.y >= r.y0 && point.y <= r.y1) {
+			found = _notes[n].index;
+		}
+	}
+
+	return found;
+}
+
+void
+NoteSet::notes_in (Rect const & r, std::vector<uint32_t>& indices) const
+{
+	for (Notes::size_type n = first_ending_after (r.x0); n < _notes.size() && _notes[n].rect.x0 < r.x1; ++n) {
+		Note const & note (_notes[n]);
+		if (note.rect.x1 > r.x0 && note.rect.y0 < r.y1 && note.rect.y1 > r.y0) {
+			indices.push_back (note.index);
+		}
+	}
+}
+
+bool
+NoteSet::covers (Duple const & point) const
+{
+	/* point is in window coordinates */
+	return note_at (window_to_item (point)) >= 0;
+}
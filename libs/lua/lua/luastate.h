@@ -34,8 +34,10 @@ public:
 	int do_command (std::string);
 	int do_file (std::string);
 	void collect_garbage ();
-	void collect_garbage_step (int debt = 0);
+	bool collect_garbage_step (int debt = 0);
 	void tweak_rt_gc ();
+	void manual_gc ();
+	int  gc_kbytes ();
 	void sandbox (bool rt_safe = false);
 
 	sigc::signal<void,std::string> Print;
@@ -76,9 +76,12 @@ LuaState::collect_garbage () {
 	lua_gc (L, LUA_GCCOLLECT, 0);
 }
 
-void
+/** @param debt amount of work in KBytes, 0: a small basic step
+ * @return true if the step finished a collection cycle
+ */
+bool
 LuaState::collect_garbage_step (int debt) {
-	lua_gc (L, LUA_GCSTEP, debt);
+	return lua_gc (L, LUA_GCSTEP, debt) == 1;
 }
 
 void
@@ -88,6 +91,17 @@ LuaState::tweak_rt_gc () {
 	lua_gc (L, LUA_GCSETSTEPMUL, 100);
 }
 
+void
+LuaState::manual_gc () {
+	/* no collection while allocating, only collect_garbage[_step] */
+	lua_gc (L, LUA_GCSTOP, 0);
+}
+
+int
+LuaState::gc_kbytes () {
+	return lua_gc (L, LUA_GCCOUNT, 0);
+}
+
 void
 LuaState::sandbox (bool rt_safe) {
 	do_command ("dofile = nil require = nil dofile = nil package = nil debug = nil os.exit = nil os.setlocale = nil rawget = nil rawset = nil coroutine = nil module = nil");
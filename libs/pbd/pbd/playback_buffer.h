@@ -46,6 +46,8 @@ public:
 		size = power_of_two_size (sz);
 		size_mask = size - 1;
 		buf = new T[size];
+		silent = new uint8_t[silent_blocks ()];
+		clear_silence ();
 
 		g_atomic_int_set (&read_idx, 0);
 		reset ();
@@ -53,6 +55,7 @@ public:
 
 	virtual ~PlaybackBuffer () {
 		delete [] buf;
+		delete [] silent;
 	}
 
 	/* init (mlock) */
@@ -77,8 +80,18 @@ public:
 		read_idx  = other.read_idx;
 		reserved  = other.reserved;
 		memset (buf, 0, size * sizeof (T));
+		memset (silent, 1, silent_blocks ());
 	}
 
+	/* write-thread, after modifying buffer () directly */
+	void clear_silence () {
+		memset (silent, 0, silent_blocks ());
+	}
+
+	/* read-thread: true if the next @a cnt samples are known to be
+	 * silent, because they were written by write_zero () */
+	bool is_silent (guint cnt) const;
+
 	/* write-thread */
 	guint write_space () const {
 		guint w, r;
@@ -133,6 +146,7 @@ public:
 	guint increment_write_ptr (guint cnt)
 	{
 		cnt = std::min (cnt, write_space ());
+		mark_written (g_atomic_int_get (&write_idx), cnt, false);
 		g_atomic_int_set (&write_idx, (g_atomic_int_get (&write_idx) + cnt) & size_mask);
 		return cnt;
 	}
@@ -188,6 +202,16 @@ private:
 	guint size;
 	guint size_mask;
 
+	/* Silence is tracked in blocks of this many samples. A block is
+	 * silent if it was written by write_zero (), starting at the block
+	 * boundary, and there was no other write to it since.
+	 */
+	static const guint silence_block = 256;
+	uint8_t* silent;
+
+	guint silent_blocks () const { return std::max (1U, size / silence_block); }
+	void mark_written (guint w, guint cnt, bool zero);
+
 	mutable gint write_idx;
 	mutable gint read_idx;
 	mutable gint reserved;
@@ -220,6 +244,8 @@ PlaybackBuffer<T>::write (T const *src, guint cnt)
 		n2 = 0;
 	}
 
+	mark_written (w, to_write, false);
+
 	memcpy (&buf[w], src, n1 * sizeof (T));
 	w = (w + n1) & size_mask;
 
@@ -254,6 +280,8 @@ PlaybackBuffer<T>::write_zero (guint cnt)
 		n2 = 0;
 	}
 
+	mark_written (w, to_write, true);
+
 	memset (&buf[w], 0, n1 * sizeof (T));
 	w = (w + n1) & size_mask;
 
@@ -317,6 +345,49 @@ PlaybackBuffer<T>::read (T *dest, guint cnt, bool commit, guint offset)
 	return to_read;
 }
 
+template<class T> /*LIBPBD_API*/ void
+PlaybackBuffer<T>::mark_written (guint w, guint cnt, bool zero)
+{
+	while (cnt > 0) {
+		const guint off = w % silence_block;
+		const guint n   = std::min (cnt, silence_block - off);
+
+		if (!zero) {
+			silent[w / silence_block] = 0;
+		} else if (off == 0) {
+			/* only a single write covering the whole block marks it */
+			silent[w / silence_block] = (n == silence_block) ? 1 : 0;
+		}
+
+		w = (w + n) & size_mask;
+		cnt -= n;
+	}
+}
+
+template<class T> /*LIBPBD_API*/ bool
+PlaybackBuffer<T>::is_silent (guint cnt) const
+{
+	if (cnt == 0 || cnt > read_space ()) {
+		return false;
+	}
+
+	guint r = g_atomic_int_get (&read_idx);
+
+	while (cnt > 0) {
+		const guint off = r % silence_block;
+		const guint n   = std::min (cnt, silence_block - off);
+
+		if (!silent[r / silence_block]) {
+			return false;
+		}
+
+		r = (r + n) & size_mask;
+		cnt -= n;
+	}
+
+	return true;
+}
+
 } /* end namespace */
 
 #endif /* __ringbuffer_h__ */
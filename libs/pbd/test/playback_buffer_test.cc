@@ -0,0 +1,59 @@
+#include "playback_buffer_test.h"
+#include "pbd/playback_buffer.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PlaybackBufferTest);
+
+using namespace std;
+
+void
+PlaybackBufferTest::testSilence ()
+{
+	PBD::PlaybackBuffer<float> pb (8192, 0);
+	float data[1024];
+
+	for (int i = 0; i < 1024; ++i) {
+		data[i] = 1.f;
+	}
+
+	/* nothing written yet */
+	CPPUNIT_ASSERT (!pb.is_silent (1));
+
+	CPPUNIT_ASSERT_EQUAL (1024U, pb.write_zero (1024));
+	CPPUNIT_ASSERT (pb.is_silent (1024));
+	/* more than can be read */
+	CPPUNIT_ASSERT (!pb.is_silent (1025));
+
+	/* data following silence in the same block */
+	pb.write_zero (100);
+	pb.write (data, 100);
+	CPPUNIT_ASSERT (pb.is_silent (1024));
+	CPPUNIT_ASSERT (!pb.is_silent (1100));
+
+	pb.increment_read_ptr (1024);
+	CPPUNIT_ASSERT (!pb.is_silent (1));
+
+	/* silence following data in the same block is not tracked */
+	pb.write_zero (1024);
+	pb.increment_read_ptr (200);
+	CPPUNIT_ASSERT (!pb.is_silent (1));
+	pb.increment_read_ptr (56);
+	CPPUNIT_ASSERT (pb.is_silent (768));
+
+	/* direct modification */
+	pb.clear_silence ();
+	CPPUNIT_ASSERT (!pb.is_silent (1));
+
+	/* silence is tracked across the wrap of the buffer */
+	pb.reset ();
+	for (int i = 0; i < 8; ++i) {
+		pb.write (data, 1000);
+		pb.increment_read_ptr (1000);
+	}
+	CPPUNIT_ASSERT_EQUAL (1024U, pb.write_zero (1024));
+	CPPUNIT_ASSERT (!pb.is_silent (1024));
+	pb.increment_read_ptr (192);
+	CPPUNIT_ASSERT_EQUAL (0U, pb.read_ptr ());
+	CPPUNIT_ASSERT (pb.is_silent (768));
+	/* the last block is only partially written */
+	CPPUNIT_ASSERT (!pb.is_silent (832));
+}
@@ -0,0 +1,12 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class PlaybackBufferTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (PlaybackBufferTest);
+	CPPUNIT_TEST (testSilence);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void testSilence ();
+};
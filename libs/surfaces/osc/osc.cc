@@ -433,6 +433,8 @@ OSC::register_callbacks()
 		REGISTER_CALLBACK (serv, X_("/strip/custom/clear"), "", custom_clear);
 		REGISTER_CALLBACK (serv, X_("/surface/list"), "", surface_list);
 		REGISTER_CALLBACK (serv, X_("/surface/list"), "f", surface_list);
+		REGISTER_CALLBACK (serv, X_("/dsp_stats"), "", session_dsp_stats);
+		REGISTER_CALLBACK (serv, X_("/dsp_stats"), "f", session_dsp_stats);
 		REGISTER_CALLBACK (serv, X_("/add_marker"), "", add_marker);
 		REGISTER_CALLBACK (serv, X_("/add_marker"), "f", add_marker);
 		REGISTER_CALLBACK (serv, X_("/access_action"), "s", access_action);
@@ -662,6 +664,7 @@ OSC::register_callbacks()
 		REGISTER_CALLBACK (serv, X_("/strip/sends"), "i", route_get_sends);
 		REGISTER_CALLBACK (serv, X_("/strip/receives"), "i", route_get_receives);
 		REGISTER_CALLBACK (serv, X_("/strip/plugin/list"), "i", route_plugin_list);
+		REGISTER_CALLBACK (serv, X_("/strip/dsp_stats"), "i", route_dsp_stats);
 		REGISTER_CALLBACK (serv, X_("/strip/plugin/descriptor"), "ii", route_plugin_descriptor);
 		REGISTER_CALLBACK (serv, X_("/strip/plugin/reset"), "ii", route_plugin_reset);
 
@@ -5510,6 +5513,66 @@ OSC::route_plugin_list (int ssid, lo_message msg) {
 	return 0;
 }
 
+static void
+add_dsp_stats (lo_message reply, DSPStats const& s)
+{
+	lo_message_add_float (reply, s.avg_usec ());
+	lo_message_add_float (reply, s.percentile (95));
+	lo_message_add_float (reply, s.percentile (99));
+	lo_message_add_float (reply, s.max_usec);
+}
+
+/** reply with avg, 95th and 99th percentile and max execution time [usec]
+ * of the route and of each visible processor, see Config->get_dsp_profiling()
+ */
+int
+OSC::route_dsp_stats (int ssid, lo_message msg) {
+	if (!session) {
+		return -1;
+	}
+
+	boost::shared_ptr<Route> r = boost::dynamic_pointer_cast<Route>(get_strip (ssid, get_address (msg)));
+
+	if (!r) {
+		PBD::error << "OSC: Invalid Remote Control ID '" << ssid << "'" << endmsg;
+		return -1;
+	}
+
+	lo_message reply = lo_message_new ();
+	lo_message_add_int32 (reply, ssid);
+	add_dsp_stats (reply, r->dsp_stats ());
+
+	for (uint32_t n = 0; ; ++n) {
+		boost::shared_ptr<Processor> p = r->nth_processor (n);
+		if (!p) {
+			break;
+		}
+		if (!p->display_to_user ()) {
+			continue;
+		}
+		lo_message_add_string (reply, p->display_name ().c_str ());
+		add_dsp_stats (reply, p->dsp_stats ());
+	}
+
+	lo_send_message (get_address (msg), X_("/strip/dsp_stats"), reply);
+	lo_message_free (reply);
+	return 0;
+}
+
+void
+OSC::session_dsp_stats (lo_message msg)
+{
+	if (!session) {
+		return;
+	}
+
+	lo_message reply = lo_message_new ();
+	add_dsp_stats (reply, session->dsp_stats ());
+
+	lo_send_message (get_address (msg), X_("/dsp_stats"), reply);
+	lo_message_free (reply);
+}
+
 int
 OSC::route_plugin_descriptor (int ssid, int piid, lo_message msg) {
 	if (!session) {
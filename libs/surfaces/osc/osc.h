@@ -339,6 +339,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	void routes_list (lo_message msg);
 	int group_list (lo_message msg);
 	void surface_list (lo_message msg);
+	void session_dsp_stats (lo_message msg);
 	void transport_sample (lo_message msg);
 	void transport_speed (lo_message msg);
 	void record_enabled (lo_message msg);
@@ -392,6 +393,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	PATH_CALLBACK_MSG(sel_previous);
 	PATH_CALLBACK_MSG(sel_next);
 	PATH_CALLBACK_MSG(surface_list);
+	PATH_CALLBACK_MSG(session_dsp_stats);
 	PATH_CALLBACK_MSG(transport_sample);
 	PATH_CALLBACK_MSG(transport_speed);
 	PATH_CALLBACK_MSG(record_enabled);
@@ -674,6 +676,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	PATH_CALLBACK2_MSG(route_plugin_activate,i,i);
 	PATH_CALLBACK2_MSG(route_plugin_deactivate,i,i);
 	PATH_CALLBACK1_MSG(route_plugin_list,i);
+	PATH_CALLBACK1_MSG(route_dsp_stats,i);
 	PATH_CALLBACK2_MSG(route_plugin_descriptor,i,i);
 	PATH_CALLBACK2_MSG(route_plugin_reset,i,i);
 
@@ -708,6 +711,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	int route_plugin_activate (int rid, int piid, lo_message msg);
 	int route_plugin_deactivate (int rid, int piid, lo_message msg);
 	int route_plugin_list(int ssid, lo_message msg);
+	int route_dsp_stats (int ssid, lo_message msg);
 	int route_plugin_descriptor(int ssid, int piid, lo_message msg);
 	int route_plugin_reset(int ssid, int piid, lo_message msg);
 
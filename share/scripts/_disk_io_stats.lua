@@ -0,0 +1,45 @@
+ardour { ["type"] = "Snippet", name = "Disk I/O statistics",
+	license     = "MIT",
+	author      = "Ardour Team",
+	description = [[Print per-track disk I/O statistics (refill and flush timing, throughput, lowest buffer level)]]
+}
+
+function factory () return function ()
+
+	function print_stats (name, s)
+		if s.ops == 0 then return end
+		local secs = s.total_usec / 1e6
+		print (string.format (" * %-28s | ops: %6d  %8.2f MB/s  avg: %6.2f max: %7.2f [ms]  in I/O: %3d%%  min buffer: %3d%%",
+			string.sub (name, 0, 28), s.ops,
+			secs > 0 and s.bytes / 1048576 / secs or 0,
+			s.total_usec / s.ops / 1000.0, s.max_usec / 1000.0,
+			math.floor (100 * s.io_usec / math.max (1, s.total_usec)),
+			math.floor (100 * s.min_headroom)))
+		-- duration histogram, the last bucket (limit 0) is unbounded
+		local hist = ""
+		local b = 0
+		local prev = 0
+		repeat
+			local lim = ARDOUR.DiskIOStats.bucket_limit (b)
+			if s:histogram (b) > 0 then
+				if lim > 0 then
+					hist = hist .. string.format ("  <=%.2fms: %d", lim / 1000.0, s:histogram (b))
+				else
+					hist = hist .. string.format ("  >%.2fms: %d", prev / 1000.0, s:histogram (b))
+				end
+			end
+			prev = lim
+			b = b + 1
+		until lim == 0
+		print ("  " .. hist)
+	end
+
+	for r in Session:get_tracks ():iter () do
+		local t = r:to_track ()
+		print_stats (t:name () .. " (play)", t:playback_io_stats ())
+		print_stats (t:name () .. " (rec)", t:capture_io_stats ())
+	end
+
+	print_stats ("Session (play)", Session:playback_io_stats ())
+	print_stats ("Session (rec)", Session:capture_io_stats ())
+end end
@@ -0,0 +1,36 @@
+ardour { ["type"] = "Snippet", name = "DSP statistics",
+	license     = "MIT",
+	author      = "Ardour Team",
+	description = [[Print the execution time of each processor, route and of the process cycle (requires the dsp-profiling preference), and the latency of LV2 plugin workers]]
+}
+
+function factory () return function ()
+
+	function print_stats (name, s)
+		if s.cycles == 0 then return end
+		print (string.format (" * %-28s | cycles: %8d  avg: %7.1f  p95: %7.1f  p99: %7.1f  min: %6d  max: %7d [us]",
+			string.sub (name, 0, 28), s.cycles, s:avg_usec (),
+			s:percentile (95), s:percentile (99), s.min_usec, s.max_usec))
+	end
+
+	-- schedule to response time of LV2 plugin workers, always collected
+	print_stats ("LV2 worker latency", ARDOUR.lv2_worker_stats ())
+
+	if not ARDOUR.config ():get_dsp_profiling () then
+		print ("Enable the 'dsp-profiling' preference to collect DSP statistics")
+		return
+	end
+
+	for r in Session:get_routes ():iter () do
+		print_stats (r:name (), r:dsp_stats ())
+		local i = 0
+		while true do
+			local p = r:nth_processor (i)
+			if p:isnil () then break end
+			print_stats ("  " .. p:display_name (), p:dsp_stats ())
+			i = i + 1
+		end
+	end
+
+	print_stats ("Process cycle", Session:dsp_stats ())
+end end